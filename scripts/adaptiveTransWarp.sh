@@ -0,0 +1,53 @@
+#!/bin/bash
+#Run TransWarpExtraction on a coarse grid of iterations, then only on the iterations that pin down where chi2 first
+#and last goes above NDOF and 5*NDOF and where it's smallest.  Those are the only things warpingTable reports, and
+#most universes converge long before the 40-100 iterations that a fixed grid spends most of its time on.
+#Each round's chi2 profile is added into one Chi2_Iteration_Dists profile in outputFile.  Everything else in
+#outputFile comes from the coarse round.
+#USAGE: adaptiveTransWarp.sh outputFile maxIteration TransWarpExtraction arguments except --output_file and --num_iter
+#Set ADAPTIVE_COARSE_ITER to change the first round's iterations and ADAPTIVE_MAX_ROUNDS to limit the refinements.
+
+SCRIPT_DIR=$(dirname $(readlink -f $0))
+COARSE_ITER=${ADAPTIVE_COARSE_ITER:-"1,2,3,5,8,12,18,27,40,60"}
+MAX_ROUNDS=${ADAPTIVE_MAX_ROUNDS:-10}
+
+if [ $# -lt 3 ]
+then
+  echo "USAGE: $0 outputFile maxIteration TransWarpExtraction arguments..." >&2
+  exit 1
+fi
+
+OUTPUT=$1
+MAX_ITER=$2
+shift 2
+
+#The coarse grid always brackets the whole range so that every crossing is between two evaluated iterations
+ITER=$(echo "1,${COARSE_ITER},${MAX_ITER}" | tr ',' '\n' | awk -v max=${MAX_ITER} '$1 >= 1 && $1 <= max' | sort -nu | paste -sd ',')
+
+ROUNDS_DIR=$(mktemp -d ${OUTPUT}.rounds.XXXXXX) || exit 2
+trap "rm -rf ${ROUNDS_DIR}" EXIT
+
+for ROUND in $(seq 0 ${MAX_ROUNDS})
+do
+  echo "Adaptive scan round ${ROUND} for ${OUTPUT}: iterations ${ITER}"
+  TransWarpExtraction --output_file ${ROUNDS_DIR}/round_${ROUND}.root --num_iter ${ITER} "$@" || exit 3
+
+  if [ ${ROUND} -eq 0 ]
+  then
+    cp ${ROUNDS_DIR}/round_0.root ${ROUNDS_DIR}/combined.root || exit 4
+  fi
+  ${SCRIPT_DIR}/warpingTable --combine ${ROUNDS_DIR}/combined.root ${ROUNDS_DIR}/round_*.root || exit 5
+
+  ITER=$(${SCRIPT_DIR}/warpingTable --next-iterations ${ROUNDS_DIR}/combined.root) || exit 6
+  if [ -z "${ITER}" ]
+  then
+    break
+  fi
+done
+
+if [ -n "${ITER}" ]
+then
+  echo "Stopped after ${MAX_ROUNDS} refinements of ${OUTPUT} with iterations ${ITER} left to check." >&2
+fi
+
+mv ${ROUNDS_DIR}/combined.root ${OUTPUT}
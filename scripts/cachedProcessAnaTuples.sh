@@ -0,0 +1,187 @@
+#!/bin/bash
+#Drop-in replacement for ProcessAnaTuples that reuses histogram files it has made before.
+#The cache key is a hash of:
+#  1. The YAML configuration without comments, blank lines, or trailing whitespace
+#  2. Every tuple file's name, size, and modification time
+#  3. The ProcessAnaTuples executable and the shared libraries it links against
+#So a cosmetic edit to Systematics.yaml, Warps.yaml, or an analysis .yaml doesn't reprocess a whole playlist.
+#Set ANATUPLE_CACHE_SALT to something new to force reprocessing anyway.
+#
+#Give it more than one configuration to process the same tuples for all of them at once.  ProcessAnaTuples
+#only takes one configuration, so each one still gets its own job, but they all start together and walk
+#the tuple files in the same order.  The first job to reach a file reads it from disk and the others get
+#it from the page cache, so the tuples are only read from disk about once.  The price is that one call
+#runs a ProcessAnaTuples for each configuration at once: with a CV and a warped configuration, that's two
+#cores and about twice the memory of one ProcessAnaTuples.  Size make's -j with that in mind.
+#USAGE: cachedProcessAnaTuples.sh config.yaml [moreConfigs.yaml...] tupleFiles...
+#Writes configMC.root to the current directory for each configuration just like ProcessAnaTuples.
+#Each new file has to pass validateOutput before it's cached.  Files that don't are deleted so that a
+#crash never leaves something behind that looks finished to make.
+#
+#Set TUPLE_STAGE_DIR to a directory on a local disk to have stageTuples.sh copy the tuples there.  Processing
+#starts once the first one is copied, and the rest are copied while it runs.  The cache key still uses the
+#original tuple files.  TUPLE_PREFETCH lists tuples.txt files
+#for shards that will probably run next.  Their tuples are copied in the background while these are processed.
+#
+#Under timeStage.sh, the number of events in the tuples is reported through STAGE_ITEMS_FILE when anything was
+#processed and 0 when every configuration came from the cache, so the report has ProcessAnaTuples' events/second.
+
+CACHE_DIR=${ANATUPLE_CACHE_DIR:-"${HOME}/.cache/NucCCNeutrons/anaTuples"}
+PROCESS=${PROCESS_ANA_TUPLES:-ProcessAnaTuples}
+VALIDATE=${ANATUPLE_VALIDATE:-$(dirname $(readlink -f $0))/validateOutput}
+STAGE=$(dirname $(readlink -f $0))/stageTuples.sh
+COUNT_EVENTS=${ANATUPLE_COUNT_EVENTS:-$(dirname $(readlink -f $0))/countEvents}
+
+set -o pipefail
+
+CONFIGS=()
+while [[ "$1" == *.yaml ]]
+do
+  CONFIGS+=($1)
+  shift
+done
+
+if [ ${#CONFIGS[@]} -eq 0 -o $# -eq 0 ]
+then
+  echo "USAGE: $0 config.yaml [moreConfigs.yaml...] tupleFiles..." >&2
+  exit 1
+fi
+
+#Strip comments that YAML would ignore anyway.  A # only starts a comment at the beginning of a line
+#or after whitespace, and never inside quotes.  Regular expressions in the configuration files use #.
+effectiveYAML()
+{
+  awk '{
+         line = ""; quote = ""
+         for(i = 1; i <= length($0); ++i)
+         {
+           c = substr($0, i, 1)
+           if(quote == "" && c == "#" && (i == 1 || substr($0, i-1, 1) ~ /[ \t]/)) break
+           if(quote == "" && (c == "\"" || c == "'"'"'")) quote = c
+           else if(c == quote) quote = ""
+           line = line c
+         }
+         sub(/[ \t]+$/, "", line)
+         if(line != "") print line
+       }' "$1"
+}
+
+#Name, size, and modification time of the executable and everything it links against
+toolVersion()
+{
+  local EXECUTABLE=$(command -v ${PROCESS})
+  if [ -z "${EXECUTABLE}" ]
+  then
+    echo "Can't find ${PROCESS} on PATH." >&2
+    return 1
+  fi
+
+  stat -L -c '%n %s %Y' ${EXECUTABLE} $(ldd ${EXECUTABLE} 2>/dev/null | awk '$3 ~ /^\// {print $3}' | sort)
+}
+
+#Human-readable description of everything that goes into the key for configuration $1.
+#Saved next to the cached file for debugging.
+keyInputs()
+{
+  echo "salt: ${ANATUPLE_CACHE_SALT}"
+  echo "config:"
+  effectiveYAML $1 || return 1
+  echo "tuples:"
+  echo "${TUPLE_VERSIONS}"
+  echo "tool:"
+  echo "${TOOL_VERSION}"
+}
+
+TOOL_VERSION=$(toolVersion) || exit 2
+TUPLE_VERSIONS=$(stat -L -c '%n %s %Y' "$@" | sort) || exit 3
+
+#Configurations that aren't in the cache yet and the keys to save them under
+TO_PROCESS=()
+KEYS=()
+for CONFIG in ${CONFIGS[@]}
+do
+  OUTPUT=$(basename ${CONFIG} .yaml)MC.root
+  KEY=$(keyInputs ${CONFIG} | sha256sum | cut -d ' ' -f 1) || exit 3
+  CACHED=${CACHE_DIR}/${KEY}.root
+
+  if [ -e ${CACHED} ]
+  then
+    echo "Reusing ${CACHED} for ${OUTPUT} in $(pwd)"
+    #Hard link when the cache is on the same filesystem.  Nothing downstream modifies these files.
+    #touch so that make sees a new file instead of one as old as the cache entry.
+    ln -f ${CACHED} ${OUTPUT} 2>/dev/null || (cp ${CACHED} .partial_${OUTPUT} && mv -f .partial_${OUTPUT} ${OUTPUT}) || exit 4
+    touch ${OUTPUT}
+  else
+    TO_PROCESS+=(${CONFIG})
+    KEYS+=(${KEY})
+  fi
+done
+
+#Read the tuples from a local disk if there's anything to process
+TUPLES=("$@")
+if [ -n "${TUPLE_STAGE_DIR}" -a ${#TO_PROCESS[@]} -gt 0 ]
+then
+  trap "${STAGE} release $$" EXIT
+  TUPLES=($(${STAGE} stage $$ "$@")) || TUPLES=("$@")
+
+  if [ -n "${TUPLE_PREFETCH}" ]
+  then
+    setsid ${STAGE} prefetch $(cat ${TUPLE_PREFETCH} 2>/dev/null) > /dev/null 2>&1 < /dev/null &
+  fi
+fi
+
+#Start every configuration that missed the cache at the same time so they share reads of the tuples
+PIDS=()
+for CONFIG in ${TO_PROCESS[@]}
+do
+  ${PROCESS} ${CONFIG} "${TUPLES[@]}" &
+  PIDS+=($!)
+done
+
+STATUS=0
+for WHICH in ${!TO_PROCESS[@]}
+do
+  CONFIG=${TO_PROCESS[${WHICH}]}
+  KEY=${KEYS[${WHICH}]}
+  OUTPUT=$(basename ${CONFIG} .yaml)MC.root
+
+  if ! wait ${PIDS[${WHICH}]}
+  then
+    echo "${PROCESS} failed for ${CONFIG} in $(pwd)." >&2
+    rm -f ${OUTPUT}
+    STATUS=5
+    continue
+  fi
+
+  if [ -x ${VALIDATE} ] && ! ${VALIDATE} -k POTUsed ${OUTPUT}
+  then
+    echo "${PROCESS} wrote an invalid ${OUTPUT} for ${CONFIG} in $(pwd).  Deleting it." >&2
+    rm -f ${OUTPUT}
+    STATUS=6
+    continue
+  fi
+
+  #Copy into the cache under a temporary name first so that a concurrent job never sees half a file
+  mkdir -p ${CACHE_DIR}
+  TMP_CACHED=$(mktemp ${CACHE_DIR}/.${KEY}.XXXXXX)
+  if cp ${OUTPUT} ${TMP_CACHED}
+  then
+    keyInputs ${CONFIG} > ${CACHE_DIR}/${KEY}.inputs
+    mv -f ${TMP_CACHED} ${CACHE_DIR}/${KEY}.root
+  else
+    echo "Failed to save ${OUTPUT} to the cache at ${CACHE_DIR}.  Carrying on without it." >&2
+    rm -f ${TMP_CACHED}
+  fi
+done
+
+if [ -n "${STAGE_ITEMS_FILE}" -a -x ${COUNT_EVENTS} ]
+then
+  if [ ${#TO_PROCESS[@]} -eq 0 ]
+  then
+    echo "0 events" > ${STAGE_ITEMS_FILE}
+  else
+    EVENTS=$(${COUNT_EVENTS} "${TUPLES[@]}") && echo "${EVENTS} events" > ${STAGE_ITEMS_FILE}
+  fi
+fi
+
+exit ${STATUS}
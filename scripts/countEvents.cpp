@@ -0,0 +1,67 @@
+//File: countEvents.cpp
+//Brief: Counts the events in anaTuples so that timeStage.sh can report how many events per second
+//       ProcessAnaTuples got through.  Every TTree in a tuple file except Meta counts because ProcessAnaTuples
+//       loops over both the reconstructed tree and the Truth tree.  Only each TTree's header is read.
+//       Compiled with -DBUILD_STANDALONE (scripts/CMakeLists.txt does this), it becomes a countEvents
+//       program that prints the total for many files at once.
+//Usage: root -l -b -q countEvents.cpp+("tuple.root")
+//       countEvents tuples...
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#include "TFile.h"
+#include "TKey.h"
+#include "TClass.h"
+#include "TTree.h"
+
+#include <iostream>
+#include <memory>
+#include <set>
+
+//Returns the number of events in fileName's TTrees, or -1 if it can't be opened
+Long64_t countEvents(const std::string& fileName)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+  if(!file || file->IsZombie())
+  {
+    std::cerr << fileName << " isn't a ROOT file that can be opened.\n";
+    return -1;
+  }
+
+  Long64_t nEvents = 0;
+  std::set<std::string> alreadyCounted;
+  for(auto obj: *file->GetListOfKeys())
+  {
+    auto key = static_cast<TKey*>(obj);
+    if(std::string(key->GetName()) == "Meta" || !alreadyCounted.insert(key->GetName()).second) continue; //Keys are listed newest cycle first
+
+    auto keyClass = TClass::GetClass(key->GetClassName());
+    if(!keyClass || !keyClass->InheritsFrom(TTree::Class())) continue;
+
+    std::unique_ptr<TTree> tree(static_cast<TTree*>(key->ReadObj()));
+    if(tree) nEvents += tree->GetEntries();
+  }
+
+  return nEvents;
+}
+
+#ifdef BUILD_STANDALONE
+int main(const int argc, const char** argv)
+{
+  if(argc < 2)
+  {
+    std::cerr << "USAGE: " << argv[0] << " tuples...\n";
+    return 2;
+  }
+
+  Long64_t nEvents = 0;
+  for(int whichArg = 1; whichArg < argc; ++whichArg)
+  {
+    const Long64_t inFile = countEvents(argv[whichArg]);
+    if(inFile < 0) return 1;
+    nEvents += inFile;
+  }
+
+  std::cout << nEvents << "\n";
+  return 0;
+}
+#endif //BUILD_STANDALONE
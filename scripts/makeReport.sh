@@ -0,0 +1,87 @@
+#!/bin/bash
+#Summarize the steps that timeStage.sh logged for one warping study.  Writes three files to reportDirectory:
+#  report.csv: every step with a header, in the order they started
+#  report.json: totals for each kind of step followed by every step.  cpuPerWall near the number of threads
+#               a step uses means it was busy computing.  Much less than that means it was waiting, usually on I/O.
+#               itemsPerSecond is in each stage's itemUnit: events for anaTuples, universes for transWarp, and
+#               files for merge.  Only anaTuples reads events, so the other stages count what they work through.
+#  trace.json: a timeline for chrome://tracing or https://ui.perfetto.dev with one row per step running at once
+#USAGE: makeReport.sh stages.txt reportDirectory
+
+if [ $# -ne 2 ]
+then
+  echo "USAGE: $0 stages.txt reportDirectory" >&2
+  exit 1
+fi
+
+STAGE_LOG=$1
+REPORT_DIR=$2
+
+if [ ! -s ${STAGE_LOG} ]
+then
+  echo "No steps were logged in ${STAGE_LOG}, so there's nothing to report." >&2
+  exit 2
+fi
+
+mkdir -p ${REPORT_DIR} || exit 3
+SORTED=$(sort -t ',' -k 5,5n ${STAGE_LOG})
+
+(echo "run,stage,target,exitCode,startSeconds,wallSeconds,cpuSeconds,maxRSSkB,readBytes,writtenBytes,storageReadBytes,storageWrittenBytes,items,itemUnit"
+ echo "${SORTED}") > ${REPORT_DIR}/report.csv
+
+echo "${SORTED}" | awk -F ',' '
+  function quote(text) { gsub(/\\/, "\\\\", text); gsub(/"/, "\\\"", text); return "\"" text "\"" }
+  function number(value) { return value == "" ? "null" : value }
+  {
+    ++nSteps
+    run = $1
+    if(nSteps == 1 || $5 < first) first = $5
+    if(nSteps == 1 || $5 + $6 > last) last = $5 + $6
+
+    if(!($2 in count)) order[++nStages] = $2
+    ++count[$2]
+    if($4 != 0) ++failed[$2]
+    wall[$2] += $6
+    cpu[$2] += $7
+    if($8 > maxRSS[$2]) maxRSS[$2] = $8
+    readBytes[$2] += $9
+    written[$2] += $10
+    storageRead[$2] += $11
+    storageWritten[$2] += $12
+    if($13 != "") { items[$2] += $13; unit[$2] = $14 }
+
+    steps[nSteps] = sprintf("{\"stage\": %s, \"target\": %s, \"exitCode\": %d, \"startSeconds\": %s, \"wallSeconds\": %s, \"cpuSeconds\": %s, \"maxRSSkB\": %s, \"readBytes\": %s, \"writtenBytes\": %s, \"storageReadBytes\": %s, \"storageWrittenBytes\": %s, \"items\": %s, \"itemUnit\": %s}",
+                            quote($2), quote($3), $4, $5, $6, $7, number($8), $9, $10, $11, $12, number($13), quote($14))
+  }
+  END {
+    printf "{\n  \"run\": %s,\n  \"wallSeconds\": %.3f,\n  \"stages\": [\n", quote(run), last - first
+    for(whichStage = 1; whichStage <= nStages; ++whichStage)
+    {
+      name = order[whichStage]
+      printf "    {\"stage\": %s, \"steps\": %d, \"failed\": %d, \"wallSeconds\": %.3f, \"cpuSeconds\": %.2f, \"cpuPerWall\": %.2f, \"maxRSSkB\": %s, \"readBytes\": %.0f, \"writtenBytes\": %.0f, \"storageReadBytes\": %.0f, \"storageWrittenBytes\": %.0f, \"readMBPerSecond\": %.2f",
+             quote(name), count[name], failed[name], wall[name], cpu[name], (wall[name] > 0 ? cpu[name]/wall[name] : 0), number(maxRSS[name]),
+             readBytes[name], written[name], storageRead[name], storageWritten[name], (wall[name] > 0 ? readBytes[name]/wall[name]/1e6 : 0)
+      if(name in items) printf ", \"items\": %.0f, \"itemUnit\": %s, \"itemsPerSecond\": %.3f", items[name], quote(unit[name]), (wall[name] > 0 ? items[name]/wall[name] : 0)
+      printf "}%s\n", (whichStage < nStages ? "," : "")
+    }
+    printf "  ],\n  \"steps\": [\n"
+    for(whichStep = 1; whichStep <= nSteps; ++whichStep) printf "    %s%s\n", steps[whichStep], (whichStep < nSteps ? "," : "")
+    printf "  ]\n}\n"
+  }' > ${REPORT_DIR}/report.json
+
+#Chrome trace events use microseconds.  Each step goes on the first row that is free when it starts.
+echo "${SORTED}" | awk -F ',' '
+  function quote(text) { gsub(/\\/, "\\\\", text); gsub(/"/, "\\\"", text); return "\"" text "\"" }
+  function number(value) { return value == "" ? "null" : value }
+  NR == 1 { first = $5; printf "{\"traceEvents\": [\n" }
+  {
+    row = 0
+    while(row in busyUntil && busyUntil[row] > $5) ++row
+    busyUntil[row] = $5 + $6
+
+    printf "%s  {\"name\": %s, \"cat\": %s, \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.0f, \"dur\": %.0f, \"args\": {\"exitCode\": %d, \"cpuSeconds\": %s, \"maxRSSkB\": %s, \"readBytes\": %s, \"writtenBytes\": %s}}",
+           (NR > 1 ? ",\n" : ""), quote($3), quote($2), row, ($5 - first)*1e6, $6*1e6, $4, $7, number($8), $9, $10
+  }
+  END { printf "\n], \"displayTimeUnit\": \"ms\"}\n" }' > ${REPORT_DIR}/trace.json
+
+echo "Wrote a report on $(echo "${SORTED}" | wc -l) steps to ${REPORT_DIR}"
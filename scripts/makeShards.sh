@@ -0,0 +1,52 @@
+#!/bin/bash
+#Split one playlist's tuple files into shards of about the same total size so that runWarping.make can
+#spread a big playlist over many cores instead of running it on one core at the end of a study.
+#Uses the longest-processing-time-first rule: biggest file first, always to the shard that's smallest so far.
+#Each shard gets a directory with a tuples.txt listing its files.  tuples.txt is only rewritten when its
+#contents change so that make doesn't reprocess shards that didn't change.
+#Prints a makefile fragment that lists the shards in PLAYLIST_SHARDS.
+#USAGE: makeShards.sh bytesPerShard playlistDirectory tupleFiles... > playlistDirectory/shards.mk
+
+if [ $# -lt 3 ]
+then
+  echo "USAGE: $0 bytesPerShard playlistDirectory tupleFiles..." >&2
+  exit 1
+fi
+
+BYTES_PER_SHARD=$1
+PLAYLIST=$2
+shift 2
+
+set -o pipefail
+
+#One line per file: shard number and file name
+ASSIGNMENTS=$(stat -L -c '%s %n' "$@" | sort -rn | awk -v bytesPerShard=${BYTES_PER_SHARD} '
+  { size[NR] = $1; name[NR] = $2; total += $1 }
+  END {
+    nShards = int((total + bytesPerShard - 1) / bytesPerShard)
+    if(nShards < 1) nShards = 1
+    if(nShards > NR) nShards = NR
+    for(shard = 0; shard < nShards; ++shard) load[shard] = 0
+    for(file = 1; file <= NR; ++file)
+    {
+      smallest = 0
+      for(shard = 1; shard < nShards; ++shard) if(load[shard] < load[smallest]) smallest = shard
+      load[smallest] += size[file]
+      print smallest, name[file]
+    }
+  }') || exit 2
+
+SHARDS=$(echo "${ASSIGNMENTS}" | cut -d ' ' -f 1 | sort -nu)
+for SHARD in ${SHARDS}
+do
+  SHARD_DIR=${PLAYLIST}/shard_${SHARD}
+  mkdir -p ${SHARD_DIR}
+  NEW_LIST=$(echo "${ASSIGNMENTS}" | awk -v shard=${SHARD} '$1 == shard {print $2}' | sort)
+  if [ "${NEW_LIST}" != "$(cat ${SHARD_DIR}/tuples.txt 2>/dev/null)" ]
+  then
+    echo "${NEW_LIST}" > ${SHARD_DIR}/tuples.txt
+  fi
+done
+
+echo "#Generated by makeShards.sh: $# tuple files in $(echo ${SHARDS} | wc -w) shards of about ${BYTES_PER_SHARD} bytes"
+echo "$(basename ${PLAYLIST})_SHARDS:=$(for SHARD in ${SHARDS}; do echo -n "${PLAYLIST}/shard_${SHARD} "; done)"
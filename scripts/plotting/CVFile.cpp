@@ -0,0 +1,148 @@
+//File: CVFile.cpp
+//Brief: The central values of the MnvH1Ds in a NucCCNeutrons output file with their errors and none of their universes.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/CVFile.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+
+//ROOT includes
+#include "TNamed.h"
+#include "TKey.h"
+#include "TClass.h"
+
+//c++ includes
+#include <iostream>
+#include <algorithm>
+#include <set>
+#include <cstdio>
+
+//POSIX includes
+#include <unistd.h>
+
+namespace
+{
+  //Name of the TNamed in each companion file that says which version of the .root file it came from
+  const std::string versionName = "CVFileVersion";
+
+  bool upToDate(TFile* cvs, const std::string& version)
+  {
+    if(!cvs || cvs->IsZombie() || cvs->TestBit(TFile::kRecovered)) return false;
+    auto written = dynamic_cast<TNamed*>(cvs->Get(versionName.c_str()));
+    return written && version == written->GetTitle();
+  }
+}
+
+namespace plot
+{
+  CVFile::CVFile(TFile& file, const KeyIndex& index): fFile(file), fIndex(index), fCompanion(companionName(file.GetName())),
+                                                      fVersion(KeyIndex::version(file))
+  {
+    fCVs.reset(TFile::Open(fCompanion.c_str(), "READ"));
+    if(!upToDate(fCVs.get(), fVersion)) fCVs.reset();
+  }
+
+  std::string CVFile::companionName(const std::string& fileName)
+  {
+    return fileName + ".cv.root";
+  }
+
+  TH1D* CVFile::get(const std::string& name)
+  {
+    return get(std::vector<std::string>{name}).front();
+  }
+
+  std::vector<TH1D*> CVFile::get(const std::vector<std::string>& names)
+  {
+    std::vector<TH1D*> found(names.size(), nullptr);
+    std::vector<size_t> missing;
+    const auto mnvH1D = TClass::GetClass("PlotUtils::MnvH1D");
+
+    for(size_t whichName = 0; whichName < names.size(); ++whichName)
+    {
+      auto cv = fCVs?dynamic_cast<TH1D*>(fCVs->Get(names[whichName].c_str())):nullptr;
+      if(cv)
+      {
+        found[whichName] = static_cast<TH1D*>(cv->Clone());
+        found[whichName]->SetDirectory(nullptr); //Outlives fCVs
+        continue;
+      }
+
+      //Don't read anything that isn't an MnvH1D just to find out that it's not
+      const auto key = fIndex.find(names[whichName]);
+      const auto keyClass = key?TClass::GetClass(key->className.c_str()):nullptr;
+      if(keyClass && mnvH1D && keyClass->InheritsFrom(mnvH1D)) missing.push_back(whichName);
+    }
+
+    //Read in the order the histograms are on disk so the file is read front to back once.
+    std::sort(missing.begin(), missing.end(), [this, &names](const size_t lhs, const size_t rhs) { return fIndex.find(names[lhs])->seek < fIndex.find(names[rhs])->seek; });
+
+    std::vector<std::pair<std::string, const TH1D*>> added;
+    for(const auto whichName: missing)
+    {
+      //Read a fresh copy from the key.  fFile.Get() might return one that a plot is already using.
+      const auto key = fFile.GetKey(names[whichName].c_str());
+      if(!key) continue;
+      std::unique_ptr<PlotUtils::MnvH1D> hist(dynamic_cast<PlotUtils::MnvH1D*>(key->ReadObj()));
+      if(!hist) continue;
+      hist->SetDirectory(nullptr); //So that deleting it doesn't confuse fFile
+
+      auto cv = static_cast<TH1D*>(hist->GetCVHistoWithError().Clone());
+      cv->SetDirectory(nullptr);
+      found[whichName] = cv;
+      added.emplace_back(names[whichName], cv);
+    }
+
+    if(!added.empty()) add(added);
+    return found;
+  }
+
+  //The companion is rewritten under a temporary name with everything that's already in it and then moved into place,
+  //so two plots adding to the same companion at once never see half of it.  When that happens, one plot's CVs are
+  //lost and just read again next time.
+  void CVFile::add(const std::vector<std::pair<std::string, const TH1D*>>& cvs)
+  {
+    const std::string partial = fCompanion + ".partial" + std::to_string(getpid());
+    {
+      std::unique_ptr<TFile> out(TFile::Open(partial.c_str(), "RECREATE"));
+      if(!out || out->IsZombie())
+      {
+        std::cerr << "Failed to write central values to " << fCompanion << ".  They will be read from " << fFile.GetName() << " again next time.\n";
+        std::remove(partial.c_str());
+        return;
+      }
+
+      std::set<std::string> written{versionName};
+      for(const auto& cv: cvs) written.insert(cv.first);
+
+      if(fCVs)
+      {
+        for(auto obj: *fCVs->GetListOfKeys())
+        {
+          auto key = static_cast<TKey*>(obj);
+          if(!written.insert(key->GetName()).second) continue; //Keys are listed newest cycle first
+          std::unique_ptr<TObject> old(key->ReadObj());
+          if(old) out->WriteTObject(old.get(), key->GetName());
+        }
+      }
+
+      for(const auto& cv: cvs) out->WriteTObject(cv.second, cv.first.c_str());
+
+      const TNamed version(versionName.c_str(), fVersion.c_str());
+      out->WriteTObject(&version);
+      out->Close();
+    }
+
+    fCVs.reset();
+    if(std::rename(partial.c_str(), fCompanion.c_str()) != 0)
+    {
+      std::cerr << "Failed to write central values to " << fCompanion << ".  They will be read from " << fFile.GetName() << " again next time.\n";
+      std::remove(partial.c_str());
+    }
+
+    fCVs.reset(TFile::Open(fCompanion.c_str(), "READ"));
+    if(!upToDate(fCVs.get(), fVersion)) fCVs.reset();
+  }
+}
@@ -0,0 +1,61 @@
+//File: CVFile.h
+//Brief: The central values of the MnvH1Ds in a NucCCNeutrons output file with their errors and none of their universes.
+//       Plots that just stack CVs used to read every universe of every MnvH1D only to throw them away.  The CVs that
+//       plots ask for are written to a companion file, <file>.root.cv.root, the first time they're asked for and read
+//       from there after that.  Only the MnvH1Ds whose CVs aren't in the companion yet are ever read.  The companion
+//       starts over whenever the .root file changes.
+//       The CVs keep GetCVHistoWithError()'s bin errors, statistical and systematic, because the stacked plots that
+//       use them draw the total's errors as the MC error band.  Those errors were already summed over the universes
+//       when the CV was written, so reading a CV never reads a universe.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_CVFILE_H
+#define PLOTTING_CVFILE_H
+
+//plotting includes
+#include "plotting/KeyIndex.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TH1D.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace plot
+{
+  class CVFile
+  {
+    public:
+      //Opens file's companion if it's up to date.  Nothing is read from file until get() needs it.
+      //file and index have to outlive this CVFile.
+      CVFile(TFile& file, const KeyIndex& index);
+
+      //The same TH1Ds that GetCVHistoWithError() would have returned for the MnvH1Ds called names in the same order.
+      //Systematic errors are already in their bin errors.  The caller owns them.  nullptr for names that aren't MnvH1Ds.
+      //CVs that aren't in the companion yet are read from file in the order they're on disk and added to it.  If the
+      //companion can't be written, they're still returned and just read again next time.
+      std::vector<TH1D*> get(const std::vector<std::string>& names);
+
+      //Just one CV
+      TH1D* get(const std::string& name);
+
+      //Adds CVs that a plot already has, like GetCVHistoWithError() of MnvH1Ds it read anyway, so that later plots
+      //don't have to read those MnvH1Ds.  Replaces CVs with the same names.
+      void add(const std::vector<std::pair<std::string, const TH1D*>>& cvs);
+
+      static std::string companionName(const std::string& fileName);
+
+    private:
+      TFile& fFile;
+      const KeyIndex& fIndex;
+      std::string fCompanion;
+      std::string fVersion;
+
+      std::unique_ptr<TFile> fCVs; //nullptr until the companion is written for this version of fFile
+  };
+}
+
+#endif //PLOTTING_CVFILE_H
@@ -0,0 +1,95 @@
+//File: CutScan.cpp
+//Brief: Every combination of a truth cut and a reco cut on a migration matrix at once.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/CutScan.h"
+
+//c++ includes
+#include <stdexcept>
+#include <cmath>
+
+namespace plot
+{
+  CutScan::CutScan(const TH2& migration, const bool xIsTrue): fNTruthCells((xIsTrue?migration.GetXaxis():migration.GetYaxis())->GetNbins() + 2),
+                                                              fNRecoCells((xIsTrue?migration.GetYaxis():migration.GetXaxis())->GetNbins() + 2)
+  {
+    addTable(migration, xIsTrue);
+  }
+
+  CutScan::CutScan(const PlotUtils::MnvH2D& migration, const bool xIsTrue): CutScan(static_cast<const TH2&>(migration), xIsTrue)
+  {
+    size_t firstUniv = 1;
+    for(const auto& name: migration.GetVertErrorBandNames())
+    {
+      const auto band = migration.GetVertErrorBand(name);
+      for(unsigned int whichUniv = 0; whichUniv < band->GetNHists(); ++whichUniv) addTable(*band->GetHist(whichUniv), xIsTrue);
+      fBands.emplace_back(firstUniv, band->GetNHists());
+      firstUniv += band->GetNHists();
+    }
+
+    for(const auto& name: migration.GetLatErrorBandNames())
+    {
+      const auto band = migration.GetLatErrorBand(name);
+      for(unsigned int whichUniv = 0; whichUniv < band->GetNHists(); ++whichUniv) addTable(*band->GetHist(whichUniv), xIsTrue);
+      fBands.emplace_back(firstUniv, band->GetNHists());
+      firstUniv += band->GetNHists();
+    }
+  }
+
+  //Each row is a running sum along reco plus the row for the truth bin below it
+  void CutScan::addTable(const TH2& migration, const bool xIsTrue)
+  {
+    const int nTruthCells = (xIsTrue?migration.GetXaxis():migration.GetYaxis())->GetNbins() + 2,
+              nRecoCells = (xIsTrue?migration.GetYaxis():migration.GetXaxis())->GetNbins() + 2;
+    if(nTruthCells != fNTruthCells || nRecoCells != fNRecoCells)
+    {
+      throw std::runtime_error(std::string(migration.GetName()) + " has different bins from the CV it's being scanned with.");
+    }
+
+    const size_t first = fSums.size();
+    fSums.resize(first + fNTruthCells*fNRecoCells);
+    double* table = fSums.data() + first;
+
+    for(int truthCell = 0; truthCell < fNTruthCells; ++truthCell)
+    {
+      double* row = table + truthCell*fNRecoCells;
+      double runningSum = 0;
+      for(int recoCell = 0; recoCell < fNRecoCells; ++recoCell)
+      {
+        runningSum += xIsTrue?migration.GetBinContent(truthCell, recoCell):migration.GetBinContent(recoCell, truthCell);
+        row[recoCell] = runningSum;
+      }
+
+      if(truthCell > 0)
+      {
+        const double* rowBelow = row - fNRecoCells;
+        for(int recoCell = 0; recoCell < fNRecoCells; ++recoCell) row[recoCell] += rowBelow[recoCell];
+      }
+    }
+  }
+
+  double CutScan::passBoth(const int truthBin, const int recoBin, const size_t whichUniv) const
+  {
+    const double passReco = passed(fNTruthCells - 1, recoBin, whichUniv);
+    return (passReco > 0)?passed(truthBin, recoBin, whichUniv)/passReco:0;
+  }
+
+  double CutScan::passBothError(const int truthBin, const int recoBin) const
+  {
+    const double cv = passBoth(truthBin, recoBin);
+    double variance = 0;
+    for(const auto& band: fBands)
+    {
+      double bandVariance = 0;
+      for(size_t whichUniv = band.first; whichUniv < band.first + band.second; ++whichUniv)
+      {
+        const double deviation = passBoth(truthBin, recoBin, whichUniv) - cv;
+        bandVariance += deviation*deviation;
+      }
+      if(band.second > 0) variance += bandVariance/band.second;
+    }
+
+    return std::sqrt(variance);
+  }
+}
@@ -0,0 +1,65 @@
+//File: CutScan.h
+//Brief: Every combination of a truth cut and a reco cut on a migration matrix at once.  CutScan sums the matrix
+//       into a summed-area table once: each cell holds how many events are at or below that truth bin and at or
+//       below that reco bin.  After that, the fraction of events that pass any pair of cuts is 2 lookups.
+//       An MnvH2D's universes are each scanned the same way to get systematic uncertainties on the fractions.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_CUTSCAN_H
+#define PLOTTING_CUTSCAN_H
+
+//PlotUtils includes
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TH2.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+
+namespace plot
+{
+  class CutScan
+  {
+    public:
+      //Scans just migration.  Truth is on the x axis with xIsTrue.
+      CutScan(const TH2& migration, const bool xIsTrue);
+
+      //Scans migration's CV and every universe of every error band
+      CutScan(const PlotUtils::MnvH2D& migration, const bool xIsTrue);
+
+      //Events at or below truthBin and at or below recoBin in universe whichUniv.  Universe 0 is the CV.
+      //Bin 0 is underflow.
+      inline double passed(const int truthBin, const int recoBin, const size_t whichUniv = 0) const
+      {
+        return fSums[(whichUniv*fNTruthCells + truthBin)*fNRecoCells + recoBin];
+      }
+
+      //Fraction of events at or below recoBin that are also at or below truthBin.
+      //0 when no events pass the reco cut.
+      double passBoth(const int truthBin, const int recoBin, const size_t whichUniv = 0) const;
+
+      //Systematic uncertainty on passBoth() in the CV from each error band's spread around the CV,
+      //added in quadrature like MnvH1D does.  0 without any universes.
+      double passBothError(const int truthBin, const int recoBin) const;
+
+      //Bins not counting underflow and overflow
+      inline int nTruthBins() const { return fNTruthCells - 2; }
+      inline int nRecoBins() const { return fNRecoCells - 2; }
+
+    private:
+      int fNTruthCells; //Bins including underflow and overflow
+      int fNRecoCells;
+
+      //One table for each universe: [(whichUniv*fNTruthCells + truthCell)*fNRecoCells + recoCell]
+      std::vector<double> fSums;
+
+      //First universe and number of universes in each error band
+      std::vector<std::pair<size_t, size_t>> fBands;
+
+      void addTable(const TH2& migration, const bool xIsTrue);
+  };
+}
+
+#endif //PLOTTING_CUTSCAN_H
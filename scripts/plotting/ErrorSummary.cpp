@@ -0,0 +1,221 @@
+//File: ErrorSummary.cpp
+//Brief: Fractional uncertainty on a histogram from each error band and each group of error bands.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/ErrorSummary.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvColors.h"
+
+//ROOT includes
+#include "TLegend.h"
+
+//c++ includes
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+//POSIX includes
+#include <unistd.h>
+
+namespace
+{
+  const int lineSize = 2;
+
+  std::vector<double> quadratureSum(const std::vector<const std::vector<double>*>& errors, const size_t nCells)
+  {
+    std::vector<double> sum(nCells, 0.);
+    for(const auto error: errors)
+    {
+      for(size_t whichCell = 0; whichCell < nCells; ++whichCell) sum[whichCell] += (*error)[whichCell]*(*error)[whichCell];
+    }
+    for(auto& cell: sum) cell = std::sqrt(cell);
+    return sum;
+  }
+
+  //A copy of binning with errors for bin contents
+  TH1D toHist(const TH1D& binning, const std::vector<double>& errors)
+  {
+    TH1D hist(binning);
+    hist.SetDirectory(nullptr);
+    hist.Reset();
+    for(int whichCell = 0; whichCell < std::min<int>(hist.GetNcells(), errors.size()); ++whichCell) hist.SetBinContent(whichCell, errors[whichCell]);
+    hist.GetYaxis()->SetTitle("Fractional Uncertainty");
+    return hist;
+  }
+
+  std::string toLine(const std::vector<double>& values)
+  {
+    std::stringstream line;
+    line.precision(std::numeric_limits<double>::max_digits10);
+    for(const auto value: values) line << " " << value;
+    return line.str();
+  }
+}
+
+namespace plot
+{
+  ErrorSummary::ErrorSummary(const PlotUtils::MnvH1D& hist, const Groups& groups): ErrorSummary(UniverseArray(hist), groups)
+  {
+  }
+
+  ErrorSummary::ErrorSummary(const UniverseArray& univs, const Groups& groups)
+  {
+    fStat = univs.statError(true);
+    fBands = univs.bandErrors(true);
+    combine(groups);
+  }
+
+  std::string ErrorSummary::sidecarName(const std::string& fileName, const std::string& histName)
+  {
+    return fileName + "." + histName + ".errors";
+  }
+
+  //The first line is the version of the .root file.  Then, there's one line for statistical errors and one line for each band.
+  ErrorSummary::ErrorSummary(const std::string& sidecar, const std::string& version, const Groups& groups)
+  {
+    std::ifstream in(sidecar);
+    std::string line;
+    if(!std::getline(in, line) || line != "#" + version) return;
+
+    std::vector<double> stat;
+    std::map<std::string, std::vector<double>> bands;
+    while(std::getline(in, line))
+    {
+      std::stringstream fields(line);
+      std::string kind, name;
+      if(!std::getline(fields, kind, '\t') || (kind == "band" && !std::getline(fields, name, '\t'))) return;
+
+      const std::vector<double> values{std::istream_iterator<double>(fields), std::istream_iterator<double>()};
+      if(kind == "stat") stat = values;
+      else if(kind == "band") bands[name] = values;
+      else return;
+    }
+
+    if(stat.empty() || std::any_of(bands.begin(), bands.end(), [&stat](const auto& band) { return band.second.size() != stat.size(); })) return;
+
+    fStat = stat;
+    fBands = bands;
+    combine(groups);
+  }
+
+  void ErrorSummary::combine(const Groups& groups)
+  {
+    const size_t nCells = fStat.size();
+    fGroups = groups;
+
+    std::set<std::string> grouped;
+    for(const auto& group: fGroups) grouped.insert(group.second.begin(), group.second.end());
+
+    std::vector<std::string> other;
+    for(const auto& band: fBands)
+    {
+      if(grouped.count(band.first) == 0) other.push_back(band.first);
+    }
+    if(!other.empty()) fGroups["Other"].insert(fGroups["Other"].end(), other.begin(), other.end());
+
+    for(const auto& group: fGroups)
+    {
+      std::vector<const std::vector<double>*> inGroup;
+      for(const auto& name: group.second)
+      {
+        const auto found = fBands.find(name);
+        if(found != fBands.end()) inGroup.push_back(&found->second);
+      }
+      fGroupErrors[group.first] = ::quadratureSum(inGroup, nCells);
+    }
+
+    std::vector<const std::vector<double>*> everything{&fStat};
+    for(const auto& band: fBands) everything.push_back(&band.second);
+    fTotal = ::quadratureSum(everything, nCells);
+  }
+
+  //Written to a temporary file first so that two plots writing the same sidecar at once never see half of it.
+  void ErrorSummary::write(const std::string& sidecar, const std::string& version) const
+  {
+    const std::string partial = sidecar + ".partial" + std::to_string(getpid());
+    {
+      std::ofstream out(partial);
+      out << "#" << version << "\n";
+      out << "stat\t" << ::toLine(fStat) << "\n";
+      for(const auto& band: fBands) out << "band\t" << band.first << "\t" << ::toLine(band.second) << "\n";
+      if(!out)
+      {
+        std::cerr << "Failed to write error bands to " << sidecar << ".  They will be calculated again next time.\n";
+        std::remove(partial.c_str());
+        return;
+      }
+    }
+
+    if(std::rename(partial.c_str(), sidecar.c_str()) != 0) std::remove(partial.c_str());
+  }
+
+  void ErrorSummary::draw(TPad& pad, const TH1D& binning) const
+  {
+    std::vector<std::pair<std::string, const std::vector<double>*>> lines;
+    for(const auto& group: fGroupErrors) lines.emplace_back(group.first, &group.second);
+
+    drawLines(pad, binning, "Total Uncertainty", fTotal, lines, true);
+  }
+
+  void ErrorSummary::drawGroup(TPad& pad, const TH1D& binning, const std::string& groupName, const double ignoreThreshold) const
+  {
+    std::vector<std::pair<std::string, const std::vector<double>*>> lines;
+    for(const auto& name: fGroups.at(groupName))
+    {
+      const auto found = fBands.find(name);
+      if(found != fBands.end() && std::any_of(found->second.begin(), found->second.end(), [ignoreThreshold](const double error) { return error > ignoreThreshold; }))
+      {
+        lines.emplace_back(name, &found->second);
+      }
+    }
+
+    drawLines(pad, binning, groupName, group(groupName), lines, false);
+  }
+
+  //Copies of everything drawn are owned by pad so that they're still there when pad is printed
+  void ErrorSummary::drawLines(TPad& pad, const TH1D& binning, const std::string& totalName, const std::vector<double>& totalErrors,
+                               const std::vector<std::pair<std::string, const std::vector<double>*>>& lines, const bool withStat) const
+  {
+    pad.cd();
+    auto legend = new TLegend(0.55, 0.6, 0.9, 0.9);
+    legend->SetBit(TObject::kCanDelete);
+
+    auto total = ::toHist(binning, totalErrors);
+    double maxError = *std::max_element(totalErrors.begin() + 1, totalErrors.end() - 1); //Not underflow or overflow
+    for(const auto& line: lines) maxError = std::max(maxError, *std::max_element(line.second->begin() + 1, line.second->end() - 1));
+    total.SetMinimum(0);
+    total.SetMaximum(1.4*maxError); //Room for the legend
+    total.SetLineColor(kBlack);
+    total.SetLineWidth(2*::lineSize);
+    legend->AddEntry(total.DrawCopy("HIST"), totalName.c_str(), "l");
+
+    if(withStat)
+    {
+      auto stat = ::toHist(binning, fStat);
+      stat.SetLineColor(kBlack);
+      stat.SetLineWidth(::lineSize);
+      stat.SetLineStyle(2); //Dashed
+      legend->AddEntry(stat.DrawCopy("HIST SAME"), "Statistical", "l");
+    }
+
+    const auto colors = MnvColors::GetColors(MnvColors::kOkabeItoDarkPalette);
+    for(size_t whichLine = 0; whichLine < lines.size(); ++whichLine)
+    {
+      auto hist = ::toHist(binning, *lines[whichLine].second);
+      hist.SetLineColor(colors[whichLine % colors.size()]);
+      hist.SetLineWidth(::lineSize);
+      hist.SetLineStyle(whichLine/colors.size() + 1); //Change line style when colors repeat
+      legend->AddEntry(hist.DrawCopy("HIST SAME"), lines[whichLine].first.c_str(), "l");
+    }
+
+    legend->Draw();
+  }
+}
@@ -0,0 +1,83 @@
+//File: ErrorSummary.h
+//Brief: Fractional uncertainty on a histogram from each error band and each group of error bands, computed in one
+//       pass over its universes.  MnvPlotter::DrawErrorSummary() recomputes every band from every universe each time
+//       it draws, and an uncertainty summary draws once for the summary and again for every group.  An ErrorSummary
+//       is written to a sidecar file next to the .root file it came from so that restyling the plots later doesn't
+//       have to read any universes.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_ERRORSUMMARY_H
+#define PLOTTING_ERRORSUMMARY_H
+
+//plotting includes
+#include "plotting/UniverseArray.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+
+//ROOT includes
+#include "TPad.h"
+#include "TH1D.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <map>
+
+namespace plot
+{
+  class ErrorSummary
+  {
+    public:
+      //Group name to the error bands in it, like MnvPlotter::error_summary_group_map
+      using Groups = std::map<std::string, std::vector<std::string>>;
+
+      //Every error band in hist in one pass over its universes.  Bands that aren't in any of groups go in "Other".
+      ErrorSummary(const PlotUtils::MnvH1D& hist, const Groups& groups);
+
+      //Same as above for a histogram that's already been unpacked
+      ErrorSummary(const UniverseArray& univs, const Groups& groups);
+
+      //Reads what write() put in sidecar.  isValid() is false if sidecar is missing or isn't for version.
+      ErrorSummary(const std::string& sidecar, const std::string& version, const Groups& groups);
+
+      //Failing to write sidecar is only a warning because everything is still in memory
+      void write(const std::string& sidecar, const std::string& version) const;
+
+      //The sidecar for the histogram called histName in fileName
+      static std::string sidecarName(const std::string& fileName, const std::string& histName);
+
+      inline bool isValid() const { return !fStat.empty(); }
+
+      //Fractional errors for each cell including underflow and overflow.  band() and group() throw std::out_of_range
+      //if there's no such band or group.
+      inline const std::vector<double>& stat() const { return fStat; }
+      inline const std::vector<double>& total() const { return fTotal; }
+      inline const std::vector<double>& band(const std::string& name) const { return fBands.at(name); }
+      inline const std::vector<double>& group(const std::string& name) const { return fGroupErrors.at(name); }
+      inline const Groups& groups() const { return fGroups; }
+
+      //Total, statistical, and each group's error like MnvPlotter::DrawErrorSummary().  binning has the same
+      //bins as the histogram this summarizes.  Whatever's drawn belongs to pad.
+      void draw(TPad& pad, const TH1D& binning) const;
+
+      //One group's error and the error from each band in it.  Skips bands whose errors are never above ignoreThreshold.
+      void drawGroup(TPad& pad, const TH1D& binning, const std::string& groupName, const double ignoreThreshold = 1e-5) const;
+
+    private:
+      std::vector<double> fStat;
+      std::vector<double> fTotal; //Statistical and every band in quadrature
+      std::map<std::string, std::vector<double>> fBands;
+
+      Groups fGroups;
+      std::map<std::string, std::vector<double>> fGroupErrors;
+
+      //Sums bands in quadrature into fTotal and each group.  Makes "Other" from bands that aren't in any group.
+      void combine(const Groups& groups);
+
+      void drawLines(TPad& pad, const TH1D& binning, const std::string& totalName, const std::vector<double>& totalErrors,
+                     const std::vector<std::pair<std::string, const std::vector<double>*>>& lines, const bool withStat) const;
+  };
+}
+
+#endif //PLOTTING_ERRORSUMMARY_H
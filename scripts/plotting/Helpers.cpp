@@ -0,0 +1,168 @@
+//File: Helpers.cpp
+//Brief: Pieces that every data/MC ratio plot used to carry its own copy of.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/Helpers.h"
+#include "plotting/KeyIndex.h"
+#include "plotting/CVFile.h"
+
+//ROOT includes
+#include "TKey.h"
+
+//c++ includes
+#include <stdexcept>
+#include <algorithm>
+
+namespace plot
+{
+  constexpr double RatioCanvas::bottomFraction;
+  constexpr double RatioCanvas::margin;
+  constexpr double RatioCanvas::labelSize;
+
+  TFile* giveMeFileOrGiveMeDeath(const std::string& fileName)
+  {
+    auto file = TFile::Open(fileName.c_str());
+    if(!file) throw std::runtime_error("Failed to open a file named " + fileName);
+    return file;
+  }
+
+  std::vector<PlotUtils::MnvH1D*> select(TFile& file, const std::regex& match, const double POTRatio)
+  {
+    return select(file, KeyIndex(file), match, POTRatio);
+  }
+
+  std::vector<PlotUtils::MnvH1D*> select(TFile& file, const KeyIndex& index, const std::regex& match, const double POTRatio)
+  {
+    const auto keys = index.match(match);
+
+    //Read in the order the histograms are on disk so the file is read front to back once.
+    std::vector<size_t> readOrder(keys.size());
+    for(size_t whichKey = 0; whichKey < keys.size(); ++whichKey) readOrder[whichKey] = whichKey;
+    std::sort(readOrder.begin(), readOrder.end(), [&keys](const size_t lhs, const size_t rhs) { return keys[lhs].seek < keys[rhs].seek; });
+
+    std::vector<PlotUtils::MnvH1D*> found(keys.size(), nullptr);
+    for(const auto whichKey: readOrder)
+    {
+      auto hist = readMnvH1D(file, keys[whichKey].name);
+      if(hist)
+      {
+        if(POTRatio != 1) hist->Scale(POTRatio);
+        found[whichKey] = hist;
+      }
+    }
+
+    found.erase(std::remove(found.begin(), found.end(), nullptr), found.end());
+    return found;
+  }
+
+  PlotUtils::MnvH1D* readMnvH1D(TFile& file, const std::string& name)
+  {
+    auto key = file.GetKey(name.c_str());
+    if(!key) return nullptr;
+    auto hist = dynamic_cast<PlotUtils::MnvH1D*>(key->ReadObj());
+    if(hist) hist->SetDirectory(nullptr); //Or it stays in file's list of objects until file is closed
+    return hist;
+  }
+
+  THStack makeStack(const std::vector<PlotUtils::MnvH1D*>& hists, const double scale)
+  {
+    THStack stacked;
+    for(auto hist: hists)
+    {
+      auto cv = static_cast<TH1D*>(hist->GetCVHistoWithError().Clone());
+      if(scale != 1) cv->Scale(scale);
+      stacked.Add(cv);
+    }
+    return stacked;
+  }
+
+  THStack selectStack(TFile& file, const std::regex& match)
+  {
+    const KeyIndex index(file);
+    CVFile cvs(file, index);
+
+    std::vector<std::string> names;
+    for(const auto& key: index.match(match)) names.push_back(key.name);
+
+    THStack stacked;
+    for(auto cv: cvs.get(names))
+    {
+      if(cv) stacked.Add(cv);
+    }
+    return stacked;
+  }
+
+  void fillRatioBand(TH1& band, const std::vector<double>& fractionalErrors)
+  {
+    for(int whichBin = 0; whichBin < static_cast<int>(fractionalErrors.size()); ++whichBin)
+    {
+      band.SetBinContent(whichBin, 1);
+      band.SetBinError(whichBin, std::max(fractionalErrors[whichBin], 1e-9)); //TH1::Draw() behaves very badly when errors are exactly 0, so set them to a very small value instead.
+    }
+  }
+
+  void applyColors(TList& hists, const std::vector<int>& colors, const int lineWidth, const bool fill)
+  {
+    for(int whichHist = 0; whichHist < hists.GetEntries(); ++whichHist)
+    {
+      auto& hist = dynamic_cast<TH1&>(*hists.At(whichHist));
+      hist.SetLineColor(colors.at(whichHist));
+      hist.SetLineWidth(lineWidth);
+      if(fill) hist.SetFillColor(colors.at(whichHist)); //Use only without nostack (Yes, that's a double negative)
+    }
+  }
+
+  RatioCanvas::RatioCanvas(const std::string& name): overall(name.c_str()),
+                                                     top("Overlay", "Overlay", 0, bottomFraction, 1, 1),
+                                                     bottom("Ratio", "Ratio", 0, 0, 1, bottomFraction + margin),
+                                                     fTitle(0.3, 0.91, 0.7, 1.0, "nbNDC"), //no border
+                                                     fPrelim(0.12, 0.75, 0.47, 0.89, "nbNDC") //no border
+  {
+    //Thou shalt Draw() new TPads lest they be blank!
+    top.Draw();
+    bottom.Draw();
+
+    bottom.SetTopMargin(0);
+    bottom.SetBottomMargin(0.3);
+  }
+
+  void RatioCanvas::styleTop(TH1& mcTotal) const
+  {
+    mcTotal.GetYaxis()->SetLabelSize(labelSize * (bottomFraction + margin));
+    mcTotal.GetYaxis()->SetTitleSize(0.06); //TODO: How to guess what these are?
+    mcTotal.GetYaxis()->SetTitleOffset(0.6);
+  }
+
+  void RatioCanvas::styleRatio(TH1& ratio) const
+  {
+    ratio.SetTitleSize(0);
+
+    ratio.GetYaxis()->SetTitle("Data / MC");
+    ratio.GetYaxis()->SetLabelSize(labelSize);
+    ratio.GetYaxis()->SetTitleSize(0.16);
+    ratio.GetYaxis()->SetTitleOffset(0.2);
+    ratio.GetYaxis()->SetNdivisions(505); //5 minor divisions between 5 major divisions
+
+    ratio.GetXaxis()->SetTitleSize(0.16);
+    ratio.GetXaxis()->SetTitleOffset(0.9);
+    ratio.GetXaxis()->SetLabelSize(labelSize);
+  }
+
+  void RatioCanvas::label(const std::string& titleText, const bool withSys)
+  {
+    top.cd();
+    fTitle.SetFillStyle(0);
+    fTitle.SetLineColor(0);
+    fTitle.AddText(titleText.c_str());
+    fTitle.Draw();
+
+    //MINERvA Preliminary
+    fPrelim.SetFillStyle(0);
+    fPrelim.SetLineColor(0);
+    fPrelim.SetTextColor(kBlue);
+    fPrelim.AddText("MINERvA Work in Progress"); //Preliminary");
+    fPrelim.AddText(withSys?"Stat. + Sys. Errors":"Stat. Errors Only");
+    fPrelim.Draw();
+  }
+}
@@ -0,0 +1,89 @@
+//File: Helpers.h
+//Brief: Pieces that every data/MC ratio plot used to carry its own copy of.  They're compiled once into
+//       libplotting along with a dictionary, so they also work from ROOT's prompt without ACLiC.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_HELPERS_H
+#define PLOTTING_HELPERS_H
+
+//plotting includes
+#include "plotting/KeyIndex.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TCanvas.h"
+#include "THStack.h"
+#include "TPaveText.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <regex>
+
+namespace plot
+{
+  //Throws std::runtime_error if fileName can't be opened
+  TFile* giveMeFileOrGiveMeDeath(const std::string& fileName);
+
+  //Every MnvH1D in file whose name matches match, scaled by POTRatio, in the order they're in the file.
+  //Uses file's KeyIndex so that nothing else gets read.  The caller owns them like readMnvH1D().
+  std::vector<PlotUtils::MnvH1D*> select(TFile& file, const std::regex& match, const double POTRatio);
+
+  //Same as above with an index that's already been read
+  std::vector<PlotUtils::MnvH1D*> select(TFile& file, const KeyIndex& index, const std::regex& match, const double POTRatio);
+
+  //A copy of the MnvH1D called name that nothing else has touched, even if file.Get() already read it.
+  //It doesn't belong to file, so the caller has to delete it.  nullptr if there's no such MnvH1D.
+  PlotUtils::MnvH1D* readMnvH1D(TFile& file, const std::string& name);
+
+  //Copies of hists' CVs with errors stacked in the same order and multiplied by scale.
+  //Scaling the CVs here is much cheaper than scaling every universe of hists.
+  THStack makeStack(const std::vector<PlotUtils::MnvH1D*>& hists, const double scale = 1);
+
+  //Same as makeStack(select(file, match, 1)), but only reads the CVs from file's CVFile.  Only MnvH1Ds that
+  //match and aren't in the CVFile yet are read from file.
+  THStack selectStack(TFile& file, const std::regex& match);
+
+  //Fills band with 1 and fractionalErrors for drawing the uncertainty on a data/MC ratio with "E2".
+  //fractionalErrors is indexed by bin like UniverseArray::totalError().
+  void fillRatioBand(TH1& band, const std::vector<double>& fractionalErrors);
+
+  //Color each histogram in hists with the next entry of colors.  Stacks that are drawn
+  //without nostack want fill.
+  void applyColors(TList& hists, const std::vector<int>& colors, const int lineWidth, const bool fill);
+
+  //A TCanvas split in 2: a top pad for overlaying data and MC and a shorter bottom pad for their ratio.
+  //The bottom pad really overlaps the top by margin to avoid drawing the x axis twice.
+  class RatioCanvas
+  {
+    public:
+      RatioCanvas(const std::string& name);
+
+      static constexpr double bottomFraction = 0.2, margin = 0.078; //margin was tuned by hand
+      static constexpr double labelSize = 0.15;
+
+      //Axis labels on the top pad sized to match the bottom pad
+      void styleTop(TH1& mcTotal) const;
+
+      //Axes for the ratio of data/MC on the bottom pad
+      void styleRatio(TH1& ratio) const;
+
+      //Title for the whole plot and MINERvA Work in Progress on the top pad.  withSys says that
+      //the errors include systematics.  Call this last so that nothing draws over them.
+      void label(const std::string& titleText, const bool withSys = false);
+
+      //Turns out that when you create a TPad while there's a TCanvas,
+      //the canvas automatically becomes the parent of that TPad.
+      //So, overall has to be constructed first.
+      TCanvas overall;
+      TPad top, bottom;
+
+    private:
+      TPaveText fTitle, fPrelim;
+  };
+}
+
+#endif //PLOTTING_HELPERS_H
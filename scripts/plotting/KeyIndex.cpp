@@ -0,0 +1,147 @@
+//File: KeyIndex.cpp
+//Brief: A list of every histogram in a NucCCNeutrons output file that can be searched without reading any of them.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/KeyIndex.h"
+
+//ROOT includes
+#include "TKey.h"
+#include "TClass.h"
+
+//c++ includes
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <set>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <cstdio>
+
+//POSIX includes
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  //Every index this process has read or built by file version.  Only the TKeys go in here, so it's small.
+  std::map<std::string, std::vector<plot::KeyInfo>> indexed;
+  std::mutex indexedMutex; //plotUncertaintySummary opens files on several threads
+}
+
+namespace plot
+{
+  KeyIndex::KeyIndex(TFile& file): fVersion(version(file))
+  {
+    std::lock_guard<std::mutex> lock(::indexedMutex);
+    const auto found = ::indexed.find(fVersion);
+    if(found != ::indexed.end())
+    {
+      fKeys = found->second;
+      return;
+    }
+
+    const std::string sidecar = sidecarName(file.GetName());
+    if(!readSidecar(sidecar))
+    {
+      build(file);
+      writeSidecar(sidecar);
+    }
+    ::indexed[fVersion] = fKeys;
+  }
+
+  std::string KeyIndex::sidecarName(const std::string& fileName)
+  {
+    return fileName + ".keys";
+  }
+
+  std::string KeyIndex::version(TFile& file)
+  {
+    struct stat info;
+    const long long mtime = (stat(file.GetName(), &info) == 0)?info.st_mtime:0;
+
+    std::stringstream version;
+    version << file.GetUUID().AsString() << " " << file.GetSize() << " " << mtime;
+    return version.str();
+  }
+
+  std::vector<KeyInfo> KeyIndex::match(const std::regex& pattern, const std::string& baseClass) const
+  {
+    const auto base = TClass::GetClass(baseClass.c_str());
+    std::vector<KeyInfo> found;
+
+    for(const auto& key: fKeys)
+    {
+      if(!std::regex_match(key.name, pattern)) continue;
+
+      const auto keyClass = TClass::GetClass(key.className.c_str());
+      if(keyClass && base && keyClass->InheritsFrom(base)) found.push_back(key);
+    }
+
+    return found;
+  }
+
+  const KeyInfo* KeyIndex::find(const std::string& name) const
+  {
+    const auto found = std::find_if(fKeys.begin(), fKeys.end(), [&name](const KeyInfo& key) { return key.name == name; });
+    return (found == fKeys.end())?nullptr:&*found;
+  }
+
+  //The first line is the version of the .root file.  Then, there's one line for each key.
+  bool KeyIndex::readSidecar(const std::string& sidecar)
+  {
+    std::ifstream in(sidecar);
+    std::string line;
+    if(!std::getline(in, line) || line != "#" + fVersion) return false;
+
+    while(std::getline(in, line))
+    {
+      std::stringstream fields(line);
+      KeyInfo key;
+      if(!std::getline(fields, key.name, '\t') || !std::getline(fields, key.className, '\t')
+         || !(fields >> key.seek >> key.nBytes))
+      {
+        fKeys.clear();
+        return false;
+      }
+      fKeys.push_back(key);
+    }
+
+    return true;
+  }
+
+  //Everything in the index comes from TKeys, so no histogram is read
+  void KeyIndex::build(TFile& file)
+  {
+    std::set<std::string> alreadyListed;
+
+    for(auto obj: *file.GetListOfKeys())
+    {
+      auto key = static_cast<TKey*>(obj);
+      if(!alreadyListed.insert(key->GetName()).second) continue; //Keys are listed newest cycle first
+
+      fKeys.push_back(KeyInfo{key->GetName(), key->GetClassName(), key->GetSeekKey(), key->GetNbytes()});
+    }
+  }
+
+  //Written to a temporary file first so that two plots opening the same file at once never see half a sidecar.
+  //Failing to write it is only a warning because the index is still in memory.
+  void KeyIndex::writeSidecar(const std::string& sidecar) const
+  {
+    const std::string partial = sidecar + ".partial" + std::to_string(getpid());
+    {
+      std::ofstream out(partial);
+      out << "#" << fVersion << "\n";
+      for(const auto& key: fKeys) out << key.name << "\t" << key.className << "\t" << key.seek << " " << key.nBytes << "\n";
+      if(!out)
+      {
+        std::cerr << "Failed to write an index of keys to " << sidecar << ".  It will be built again the next time a program opens this file.\n";
+        std::remove(partial.c_str());
+        return;
+      }
+    }
+
+    if(std::rename(partial.c_str(), sidecar.c_str()) != 0) std::remove(partial.c_str());
+  }
+}
@@ -0,0 +1,63 @@
+//File: KeyIndex.h
+//Brief: A list of every histogram in a NucCCNeutrons output file that can be searched without reading any of them.
+//       NucCCNeutrons files have thousands of keys, and most of them are big MnvH1Ds.  So, KeyIndex writes what it
+//       learns about each key to a sidecar file next to the .root file the first time it opens that file and just
+//       reads the sidecar from then on.  The sidecar is rebuilt whenever the .root file changes.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_KEYINDEX_H
+#define PLOTTING_KEYINDEX_H
+
+//ROOT includes
+#include "TFile.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <regex>
+
+namespace plot
+{
+  //Everything in the sidecar file about one key
+  struct KeyInfo
+  {
+    std::string name;
+    std::string className;
+    Long64_t seek; //Where this key starts in the file
+    int nBytes; //Size of this key on disk, compressed
+  };
+
+  class KeyIndex
+  {
+    public:
+      //Reads file's sidecar, or builds and writes it if it's missing or out of date.  Only TKeys are read to build it.
+      //Each version of a file is only indexed once per process even if its sidecar can't be written.
+      KeyIndex(TFile& file);
+
+      //Keys whose names match and whose classes inherit from baseClass in the order they are in the file.
+      //Only the newest cycle of each key is listed.
+      std::vector<KeyInfo> match(const std::regex& pattern, const std::string& baseClass = "PlotUtils::MnvH1D") const;
+
+      inline const std::vector<KeyInfo>& keys() const { return fKeys; }
+
+      //nullptr if there's no key called name
+      const KeyInfo* find(const std::string& name) const;
+
+      static std::string sidecarName(const std::string& fileName);
+
+      //Changes whenever file is rewritten, even if it gets the same size and name
+      static std::string version(TFile& file);
+
+    private:
+      std::vector<KeyInfo> fKeys;
+
+      //Identifies which version of a .root file a sidecar describes
+      std::string fVersion;
+
+      bool readSidecar(const std::string& sidecar);
+      void build(TFile& file);
+      void writeSidecar(const std::string& sidecar) const;
+  };
+}
+
+#endif //PLOTTING_KEYINDEX_H
@@ -0,0 +1,32 @@
+//File: LinkDef.h
+//Brief: Tells rootcling what to put in libplotting's dictionary so that ROOT's prompt can use it without ACLiC.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifdef __CINT__
+#pragma link off all globals;
+#pragma link off all classes;
+#pragma link off all functions;
+
+#pragma link C++ namespace plot;
+#pragma link C++ function plot::giveMeFileOrGiveMeDeath;
+#pragma link C++ function plot::select;
+#pragma link C++ function plot::makeStack;
+#pragma link C++ function plot::selectStack;
+#pragma link C++ function plot::applyColors;
+#pragma link C++ class plot::RatioCanvas-;
+#pragma link C++ struct plot::KeyInfo-;
+#pragma link C++ class plot::KeyIndex-;
+#pragma link C++ class plot::CVFile-;
+#pragma link C++ struct plot::Sample-;
+#pragma link C++ class plot::RenderPool-;
+#pragma link C++ function plot::POTUsed;
+#pragma link C++ function plot::sidebandRatio;
+#pragma link C++ function plot::backgroundBreakdown;
+#pragma link C++ function plot::readMnvH1D;
+#pragma link C++ class plot::UniverseArray-;
+#pragma link C++ function plot::sum;
+#pragma link C++ class plot::CutScan-;
+#pragma link C++ class plot::ErrorSummary-;
+#pragma link C++ class plot::ProjectionCache-;
+#pragma link C++ struct plot::ProjectionCache::Projection-;
+#endif
@@ -0,0 +1,103 @@
+//File: ProjectionCache.cpp
+//Brief: Every projection of an MnvH2D that a set of plots asks for, each made only once.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/ProjectionCache.h"
+
+namespace
+{
+  std::vector<double> edgesOf(const TAxis& axis)
+  {
+    std::vector<double> edges;
+    for(int whichBin = 1; whichBin <= axis.GetNbins() + 1; ++whichBin) edges.push_back(axis.GetBinLowEdge(whichBin));
+    return edges;
+  }
+
+  //Suffix like MnvH2D::ProjectionX()'s default name
+  std::string projectionName(const std::string& histName, const char axis, const int first, const int last)
+  {
+    std::string name = histName + "_p" + axis;
+    if(last >= first) name += "_" + std::to_string(first) + "_" + std::to_string(last);
+    return name;
+  }
+}
+
+namespace plot
+{
+  const UniverseArray& ProjectionCache::unpack(const PlotUtils::MnvH2D& hist)
+  {
+    auto& found = fUnpacked[hist.GetName()];
+    if(!found) found.reset(new Unpacked{UniverseArray(hist), ::edgesOf(*hist.GetXaxis()), ::edgesOf(*hist.GetYaxis()),
+                                        hist.GetXaxis()->GetTitle(), hist.GetYaxis()->GetTitle()});
+    return found->univs;
+  }
+
+  const UniverseArray& ProjectionCache::insert(const std::string& name, const UniverseArray& univs, const TH2& binning)
+  {
+    for(auto projection = fProjections.begin(); projection != fProjections.end(); )
+    {
+      if(std::get<0>(projection->first) == name) projection = fProjections.erase(projection);
+      else ++projection;
+    }
+
+    auto& inserted = fUnpacked[name];
+    inserted.reset(new Unpacked{univs, ::edgesOf(*binning.GetXaxis()), ::edgesOf(*binning.GetYaxis()),
+                                binning.GetXaxis()->GetTitle(), binning.GetYaxis()->GetTitle()});
+    return inserted->univs;
+  }
+
+  const ProjectionCache::Projection& ProjectionCache::project(const PlotUtils::MnvH2D& hist, const char axis, const int first, const int last)
+  {
+    unpack(hist);
+    return project(hist.GetName(), axis, first, last);
+  }
+
+  const ProjectionCache::Projection& ProjectionCache::project(const std::string& name, const char axis, const int first, const int last)
+  {
+    auto& found = fProjections[std::make_tuple(name, axis, first, last)];
+    if(!found)
+    {
+      const auto& hist = *fUnpacked.at(name);
+      auto univs = hist.univs.project(axis, first, last);
+      auto cv = cvOf(hist, univs, ::projectionName(name, axis, first, last), axis);
+      found.reset(new Projection{std::move(univs), cv});
+    }
+    return *found;
+  }
+
+  UniverseArray ProjectionCache::efficiency(const std::string& numName, const std::string& denName) const
+  {
+    UniverseArray ratio = fUnpacked.at(numName)->univs;
+    ratio /= fUnpacked.at(denName)->univs;
+    return ratio;
+  }
+
+  ProjectionCache::Projection ProjectionCache::efficiency(const std::string& numName, const std::string& denName, const char axis, const int first, const int last)
+  {
+    UniverseArray ratio = project(numName, axis, first, last).univs;
+    ratio /= project(denName, axis, first, last).univs;
+
+    auto cv = cvOf(*fUnpacked.at(numName), ratio, ::projectionName(numName + "_efficiency", axis, first, last), axis);
+    cv.GetYaxis()->SetTitle("Efficiency");
+    return Projection{std::move(ratio), cv};
+  }
+
+  TH1D ProjectionCache::cvOf(const Unpacked& hist, const UniverseArray& univs, const std::string& name, const char axis)
+  {
+    const auto& edges = (axis == 'x')?hist.xEdges:hist.yEdges;
+    const std::string title = ";" + ((axis == 'x')?hist.xTitle:hist.yTitle);
+    TH1D cv(name.c_str(), title.c_str(), edges.size() - 1, edges.data());
+    cv.SetDirectory(nullptr);
+
+    const double* contents = univs.column(0);
+    const auto errors = univs.statError();
+    for(int whichCell = 0; whichCell < univs.nCells(); ++whichCell)
+    {
+      cv.SetBinContent(whichCell, contents[whichCell]);
+      cv.SetBinError(whichCell, errors[whichCell]);
+    }
+
+    return cv;
+  }
+}
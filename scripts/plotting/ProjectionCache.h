@@ -0,0 +1,81 @@
+//File: ProjectionCache.h
+//Brief: Every projection of an MnvH2D that a set of plots asks for, each made only once.  MnvH2D::ProjectionY()
+//       builds a new MnvH1D with every universe of every error band each time it's called, so a plot that projects
+//       the same histogram twice pays for it twice.  A ProjectionCache unpacks each MnvH2D into a UniverseArray once,
+//       projects every universe at once, and keeps the result keyed by histogram name, axis, and range of bins.
+//       It also divides efficiency numerators by denominators in all universes at once.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_PROJECTIONCACHE_H
+#define PLOTTING_PROJECTIONCACHE_H
+
+//plotting includes
+#include "plotting/UniverseArray.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TH1D.h"
+#include "TH2.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <memory>
+
+namespace plot
+{
+  class ProjectionCache
+  {
+    public:
+      //Every universe of one projection and its CV with statistical errors to draw
+      struct Projection
+      {
+        UniverseArray univs;
+        TH1D cv;
+      };
+
+      //hist's CV and universes, unpacked the first time hist's name is seen.  hist must not change after that.
+      const UniverseArray& unpack(const PlotUtils::MnvH2D& hist);
+
+      //Keeps univs under name so that it can be projected like an unpacked MnvH2D.  binning has the same bins as univs.
+      //Forgets anything already called name and every projection of it.
+      const UniverseArray& insert(const std::string& name, const UniverseArray& univs, const TH2& binning);
+
+      //Projection onto axis 'x' or 'y' of bins first through last of the other axis like UniverseArray::project().
+      //Only the first call for each histogram name, axis, and range does any work.  The name-only version throws
+      //std::out_of_range if nothing called name was unpacked or inserted.
+      const Projection& project(const PlotUtils::MnvH2D& hist, const char axis, const int first = 0, const int last = -1);
+      const Projection& project(const std::string& name, const char axis, const int first = 0, const int last = -1);
+
+      //numName divided by denName in every universe in one pass.  Both have to be unpacked or inserted already,
+      //so a numerator can be a sum of processes.  Throws std::out_of_range otherwise.
+      UniverseArray efficiency(const std::string& numName, const std::string& denName) const;
+
+      //Efficiency in one variable: the ratio of numName's and denName's projections, which are cached too
+      Projection efficiency(const std::string& numName, const std::string& denName, const char axis, const int first = 0, const int last = -1);
+
+    private:
+      struct Unpacked
+      {
+        UniverseArray univs;
+        std::vector<double> xEdges; //Works for variable-width bins too
+        std::vector<double> yEdges;
+        std::string xTitle;
+        std::string yTitle;
+      };
+
+      std::map<std::string, std::unique_ptr<Unpacked>> fUnpacked;
+
+      //Histogram name, axis, first bin, last bin
+      std::map<std::tuple<std::string, char, int, int>, std::unique_ptr<Projection>> fProjections;
+
+      //A TH1D with the projected axis' bins and univs' CV
+      static TH1D cvOf(const Unpacked& hist, const UniverseArray& univs, const std::string& name, const char axis);
+  };
+}
+
+#endif //PLOTTING_PROJECTIONCACHE_H
@@ -0,0 +1,99 @@
+//File: RenderPool.cpp
+//Brief: Prints canvases to image files in parallel with a forked process for each canvas.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/RenderPool.h"
+
+//c++ includes
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+//POSIX includes
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+
+namespace
+{
+  //Print to a hidden name in the same directory and rename() it when it's done so that a crash never leaves half
+  //an image behind.  Keeps the extension because TPad::Print() uses it to choose the format.
+  bool printAndCommit(TPad& canvas, const std::string& fileName)
+  {
+    const size_t slash = fileName.rfind('/');
+    const std::string dir = (slash == std::string::npos)?"":fileName.substr(0, slash + 1),
+                      partial = dir + ".partial_" + fileName.substr(dir.length());
+
+    canvas.Print(partial.c_str());
+
+    struct stat info;
+    if(stat(partial.c_str(), &info) != 0 || info.st_size == 0)
+    {
+      std::remove(partial.c_str());
+      return false;
+    }
+
+    return std::rename(partial.c_str(), fileName.c_str()) == 0;
+  }
+}
+
+namespace plot
+{
+  RenderPool::RenderPool(const int maxJobs): fMaxJobs(maxJobs)
+  {
+  }
+
+  RenderPool::~RenderPool()
+  {
+    for(const auto& failed: wait()) std::cerr << "Failed to print " << failed << ".\n";
+  }
+
+  int RenderPool::defaultJobs()
+  {
+    const char* fromEnv = std::getenv("PLOT_RENDER_JOBS");
+    if(fromEnv) return std::atoi(fromEnv);
+    return sysconf(_SC_NPROCESSORS_ONLN);
+  }
+
+  void RenderPool::print(TPad& canvas, const std::string& fileName)
+  {
+    if(fMaxJobs <= 1)
+    {
+      if(!::printAndCommit(canvas, fileName)) fFailed.push_back(fileName);
+      return;
+    }
+
+    while(static_cast<int>(fRunning.size()) >= fMaxJobs) reapOne();
+
+    std::fflush(nullptr); //Or the job prints whatever hasn't been printed yet again
+    const pid_t pid = fork();
+    if(pid == 0) _exit(::printAndCommit(canvas, fileName)?0:1); //Don't clean up anything the parent still needs
+    else if(pid < 0)
+    {
+      std::perror("Failed to start a process to print a canvas.  Printing it here instead");
+      if(!::printAndCommit(canvas, fileName)) fFailed.push_back(fileName);
+    }
+    else fRunning.emplace_back(pid, fileName);
+  }
+
+  std::vector<std::string> RenderPool::wait()
+  {
+    while(!fRunning.empty()) reapOne();
+
+    std::vector<std::string> failed;
+    failed.swap(fFailed);
+    return failed;
+  }
+
+  //Waits for the oldest job.  waitpid(-1) would steal the exit codes of processes that someone else started.
+  void RenderPool::reapOne()
+  {
+    const auto oldest = fRunning.front();
+    fRunning.pop_front();
+
+    int status = 0;
+    if(waitpid(oldest.first, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) fFailed.push_back(oldest.second);
+  }
+}
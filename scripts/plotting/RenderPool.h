@@ -0,0 +1,53 @@
+//File: RenderPool.h
+//Brief: Prints canvases to image files in parallel.  ROOT graphics isn't thread-safe, so each canvas gets its
+//       own forked process instead.  fork() hands that process a copy of the canvas exactly as it is when
+//       print() is called, so the caller can go right on to drawing the next plot on the same canvas.  At most
+//       maxJobs canvases are printed at once.  A job that crashes or doesn't write its file only loses that file.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_RENDERPOOL_H
+#define PLOTTING_RENDERPOOL_H
+
+//ROOT includes
+#include "TPad.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+
+//POSIX includes
+#include <sys/types.h>
+
+namespace plot
+{
+  class RenderPool
+  {
+    public:
+      //With maxJobs of 1 or less, print() prints right away in this process.
+      RenderPool(const int maxJobs = defaultJobs());
+
+      //Waits for every job that's still running
+      ~RenderPool();
+
+      //Print canvas to fileName like TPad::Print().  canvas can be changed or deleted as soon as this returns.
+      void print(TPad& canvas, const std::string& fileName);
+
+      //Waits for every job to finish.  Returns the files that weren't printed.
+      std::vector<std::string> wait();
+
+      //PLOT_RENDER_JOBS if it's set.  Otherwise, one job per core.
+      static int defaultJobs();
+
+    private:
+      int fMaxJobs;
+      std::deque<std::pair<pid_t, std::string>> fRunning; //File each job is printing, oldest first
+      std::vector<std::string> fFailed;
+
+      //Blocks until one job finishes
+      void reapOne();
+  };
+}
+
+#endif //PLOTTING_RENDERPOOL_H
@@ -0,0 +1,319 @@
+//File: SidebandPlots.cpp
+//Brief: Data/MC ratio plots of one sideband at a time.  backgroundBreakdown, plotSideband, and plotAllSidebands
+//       all draw them from here.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/SidebandPlots.h"
+#include "plotting/Helpers.h"
+#include "plotting/UniverseArray.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvColors.h"
+
+//ROOT includes
+#include "TParameter.h"
+#include "TStyle.h"
+#include "TLegend.h"
+#include "TList.h"
+
+//c++ includes
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+  const int lineSize = 2;
+  const double maxMC = 5e4; //Maximum across all plots I want to compare
+  const double minRatio = 0.6, maxRatio = 1.2;
+
+  void setStyle()
+  {
+    gStyle->SetOptStat(0);
+    gStyle->SetOptTitle(0); //I'll draw it myself
+    gStyle->SetTitleSize(0.08, "pad");
+  }
+
+  //plotAllSidebands draws many plots in one process, so everything a plot reads or clones has to be freed once
+  //it's printed.  THStack never deletes the histograms in it.
+  template <class HIST>
+  std::vector<std::unique_ptr<HIST>> own(const std::vector<HIST*>& hists)
+  {
+    std::vector<std::unique_ptr<HIST>> owned;
+    for(auto hist: hists) owned.emplace_back(hist);
+    return owned;
+  }
+
+  //hists is nullptr for an empty THStack
+  std::vector<std::unique_ptr<TObject>> own(TList* hists)
+  {
+    std::vector<std::unique_ptr<TObject>> owned;
+    if(hists)
+    {
+      for(auto hist: *hists) owned.emplace_back(hist);
+    }
+    return owned;
+  }
+}
+
+namespace plot
+{
+  double POTUsed(TFile& file)
+  {
+    auto POTInfo = dynamic_cast<TParameter<double>*>(file.Get("POTUsed"));
+    if(!POTInfo) throw std::runtime_error(std::string(file.GetName()) + " doesn't have POT information.");
+    return POTInfo->GetVal();
+  }
+
+  Sample::Sample(TFile& sampleFile): file(sampleFile), index(sampleFile), POT(POTUsed(sampleFile))
+  {
+  }
+
+  Sample::Sample(TFile& sampleFile, const Sample& sameFile): file(sampleFile), index(sameFile.index), POT(sameFile.POT)
+  {
+  }
+
+  int sidebandRatio(Sample& data, Sample& mc, const std::string& fiducialName, const std::string& sidebandName, const std::string& outName)
+  {
+    ::setStyle();
+
+    const std::string dataName = fiducialName + "_" + sidebandName + "_Data";
+    const std::regex find(fiducialName + "_" + sidebandName + R"(_(.*))");
+
+    //MC is scaled to data's POT only after it's summed
+    const double POTRatio = data.POT/mc.POT;
+    const auto stackHists = select(mc.file, mc.index, find, 1);
+    const auto ownStackHists = ::own(stackHists);
+    if(stackHists.empty())
+    {
+      std::cerr << "Failed to find any MC histograms for sideband " << sidebandName << " in " << mc.file.GetName() << "\n";
+      return 1;
+    }
+    auto mcStack = makeStack(stackHists, POTRatio);
+    const auto ownStackCVs = ::own(mcStack.GetHists());
+    std::unique_ptr<PlotUtils::MnvH1D> dataHist(readMnvH1D(data.file, dataName));
+    if(!dataHist)
+    {
+      std::cerr << "Failed to find a histogram named " << dataName << "\n";
+      return 1;
+    }
+
+    std::unique_ptr<TH1D> dataWithStatErr(static_cast<TH1D*>(dataHist->GetCVHistoWithError().Clone()));
+
+    std::unique_ptr<PlotUtils::MnvH1D> errBandTemplate(readMnvH1D(mc.file, fiducialName + "_" + sidebandName + "_TruthSignal"));
+    if(!errBandTemplate)
+    {
+      std::cerr << "Failed to find the signal histogram for error band " << sidebandName << "\n";
+      return 1;
+    }
+    dataHist->AddMissingErrorBandsAndFillWithCV(*errBandTemplate);
+
+    //Set histogram styles
+    applyColors(*mcStack.GetHists(), MnvColors::GetColors(MnvColors::kOkabeItoDarkPalette), ::lineSize, true);
+
+    RatioCanvas canvas("Data/MC for " + fiducialName + " " + sidebandName + " Sideband");
+    auto& top = canvas.top;
+    auto& bottom = canvas.bottom;
+
+    //Data with stacked MC
+    top.cd();
+
+    auto mcTotal = static_cast<TH1*>(mcStack.GetStack()->Last());
+    mcTotal->SetTitle("MnvGENIEv1");
+
+    //mcTotal->GetYaxis()->SetTitle("candidates / event"); //dataWithStatErr->GetYaxis()->GetTitle()); //TODO: I had the axes backwards in the original plo
+    canvas.styleTop(*mcTotal);
+
+    //mcTotal->SetLineColor(kRed);
+    //mcTotal->SetFillColorAlpha(kPink + 1, 0.4);
+    mcTotal->SetMaximum(::maxMC);
+    mcTotal->SetMinimum(0);
+    mcTotal->Draw("E2"); //Draw the error bars
+    //Even though I throw the previous line's drawing away when I Draw("HIST") without SAME,
+    //I still have to Draw() it to avoid a segmentation fault.  This is probably THStack
+    //creating some histogram on demand.
+
+    //mcStack.Draw("HISTnostackSAME");
+    mcStack.Draw("HIST");
+    auto axes = mcStack.GetHistogram(); //N.B.: GetHistogram() would have returned nullptr had I called it before Draw()!
+
+    dataWithStatErr->SetLineColor(1);
+    dataWithStatErr->SetLineWidth(::lineSize);
+    dataWithStatErr->SetMarkerStyle(20); //Resizeable closed circle
+    dataWithStatErr->SetMarkerColor(1);
+    dataWithStatErr->SetMarkerSize(0.7);
+    dataWithStatErr->SetTitle("Data");
+    dataWithStatErr->Draw("SAME");
+
+    auto legend = top.BuildLegend(0.5, 0.4, 0.9, 0.9);
+
+    //Drawing the thing that I don't want in the legend AFTER
+    //building the legend.  What a dirty hack!
+    std::unique_ptr<TH1> lineOnly(static_cast<TH1*>(mcTotal->Clone()));
+    lineOnly->SetFillStyle(0);
+    lineOnly->Draw("HISTSAME"); //Draw the line
+
+    //Data/MC ratio panel
+    bottom.cd();
+    //Dividing universe by universe carries the MC's systematics through the ratio with every correlation between bins.
+    //The ratio's statistical errors come from both data and MC.
+    UniverseArray ratioUnivs(*dataHist);
+    ratioUnivs /= sum(stackHists, POTRatio);
+    std::unique_ptr<PlotUtils::MnvH1D> ratio(ratioUnivs.toMnvH1D(*dataHist));
+
+    //Now fill mcRatio with 1 for bin content and the ratio's fractional systematic error
+    std::unique_ptr<TH1D> mcRatio(static_cast<TH1D*>(ratio->GetCVHistoWithStatError().Clone()));
+    fillRatioBand(*mcRatio, ratioUnivs.totalError(false, true));
+
+    ratio->SetTitle("");
+    ratio->SetLineWidth(::lineSize);
+    ratio->SetLineColor(kBlack);
+    canvas.styleRatio(*ratio);
+    //ratio->GetXaxis()->SetTitle("energy deposits [MeV]"); //dataWithStatErr->GetXaxis()->GetTitle()); //TODO: I had the axes backwards in the original plot
+
+    ratio->SetMinimum(::minRatio);
+    ratio->SetMaximum(::maxRatio);
+    ratio->Draw();
+
+    mcRatio->SetLineColor(kRed);
+    mcRatio->SetLineWidth(::lineSize);
+    mcRatio->SetFillColorAlpha(kPink + 1, 0.4);
+    mcRatio->Draw("E2SAME");
+
+    //Draw a flat line through the center of the MC
+    std::unique_ptr<TH1> straightLine(static_cast<TH1*>(mcRatio->Clone()));
+    straightLine->SetFillStyle(0);
+    straightLine->Draw("HISTSAME");
+
+    //Title for the whole plot
+    canvas.label(fiducialName, true);
+
+    canvas.overall.Print(outName.c_str());
+
+    return 0;
+  }
+
+  int backgroundBreakdown(Sample& data, Sample& mc, const std::string& fiducialName, const std::string& sidebandName, const bool isSelected, const std::string& outName)
+  {
+    ::setStyle();
+
+    const std::string dataName = fiducialName + "_" + sidebandName + "_" + (isSelected?"Signal":"Data"),
+                      mcSignalName = fiducialName + "_"  + sidebandName + "_" + (isSelected?"SelectedMCEvents":"TruthSignal");
+    const std::regex find(fiducialName + "_" + sidebandName + R"(_Background_(.*))");
+
+    //Stack backgrounds in alphabetical order.  MC is scaled to data's POT only after it's summed.
+    const double POTRatio = data.POT/mc.POT;
+    auto stackHists = select(mc.file, mc.index, find, 1);
+    const auto ownStackHists = ::own(stackHists);
+    std::sort(stackHists.begin(), stackHists.end(), [](const auto lhs, const auto rhs) { return std::string(lhs->GetName()) < rhs->GetName(); });
+
+    std::unique_ptr<PlotUtils::MnvH1D> mcSelected(readMnvH1D(mc.file, mcSignalName));
+    if(!mcSelected)
+    {
+      std::cerr << "Failed to find a histogram named " << mcSignalName << " in " << mc.file.GetName() << "\n";
+      return 1;
+    }
+    mcSelected->SetTitle("Signal");
+    stackHists.push_back(mcSelected.get());
+    auto mcStack = makeStack(stackHists, POTRatio);
+    const auto ownStackCVs = ::own(mcStack.GetHists());
+
+    std::unique_ptr<PlotUtils::MnvH1D> dataHist(readMnvH1D(data.file, dataName));
+    if(!dataHist)
+    {
+      std::cerr << "Failed to find a histogram named " << dataName << " in " << data.file.GetName() << "\n";
+      return 1;
+    }
+
+    std::unique_ptr<TH1D> dataWithStatErr(static_cast<TH1D*>(dataHist->GetCVHistoWithError().Clone()));
+
+    dataHist->AddMissingErrorBandsAndFillWithCV(*mcSelected);
+
+    //Set histogram styles
+    //Line widths were making it look like top histogram has contributions when it has none.
+    applyColors(*mcStack.GetHists(), MnvColors::GetColors(MnvColors::kOkabeItoDarkPalette), 0, true);
+
+    RatioCanvas canvas("Data/MC for " + fiducialName + " " + sidebandName + " Sideband");
+    auto& top = canvas.top;
+    auto& bottom = canvas.bottom;
+
+    //Data with stacked MC
+    top.cd();
+
+    auto mcTotal = static_cast<TH1*>(mcStack.GetStack()->Last());
+    mcTotal->SetTitle("MnvTunev1");
+
+    canvas.styleTop(*mcTotal);
+
+    //mcTotal->SetLineColor(kRed);
+    //mcTotal->SetFillColorAlpha(kPink + 1, 0.4);
+    //mcTotal->SetMaximum(1.5e4);
+    mcTotal->SetMaximum(2.*mcTotal->GetMaximum());
+    mcTotal->SetMinimum(0);
+    mcTotal->Draw("E2"); //Draw the error bars
+    //Even though I throw the previous line's drawing away when I Draw("HIST") without SAME,
+    //I still have to Draw() it to avoid a segmentation fault.  This is probably THStack
+    //creating some histogram on demand.
+
+    //mcStack.Draw("HISTnostackSAME");
+    mcStack.Draw("HIST");
+    auto axes = mcStack.GetHistogram(); //N.B.: GetHistogram() would have returned nullptr had I called it before Draw()!
+
+    dataWithStatErr->SetLineColor(1);
+    dataWithStatErr->SetLineWidth(::lineSize);
+    dataWithStatErr->SetMarkerStyle(20); //Resizeable closed circle
+    dataWithStatErr->SetMarkerColor(1);
+    dataWithStatErr->SetMarkerSize(0.7);
+    dataWithStatErr->SetTitle("Data");
+    dataWithStatErr->Draw("SAME");
+
+    auto legend = top.BuildLegend(0.5, 0.4, 0.9, 0.9);
+
+    //Drawing the thing that I don't want in the legend AFTER
+    //building the legend.  What a dirty hack!
+    std::unique_ptr<TH1> lineOnly(static_cast<TH1*>(mcTotal->Clone()));
+    lineOnly->SetFillStyle(0);
+    lineOnly->Draw("HISTSAME"); //Draw the line
+
+    //Data/MC ratio panel
+    bottom.cd();
+    //This is what MnvPlotter does too: Divide() MnvH1Ds directly.  Dividing universe by universe carries
+    //the MC's systematics through the ratio with every correlation between bins.
+    UniverseArray ratioUnivs(*dataHist);
+    ratioUnivs /= sum(stackHists, POTRatio);
+    std::unique_ptr<PlotUtils::MnvH1D> ratio(ratioUnivs.toMnvH1D(*dataHist));
+
+    //Now fill mcRatio with 1 for bin content and the ratio's fractional systematic error
+    auto mcRatio = ratio->GetCVHistoWithStatError();
+    fillRatioBand(mcRatio, ratioUnivs.totalError(false, true));
+
+    ratio->SetTitle("");
+    ratio->SetLineWidth(::lineSize);
+    ratio->SetLineColor(kBlack);
+    canvas.styleRatio(*ratio);
+
+    /*ratio->SetMinimum(::minRatio);
+    ratio->SetMaximum(::maxRatio);*/
+    ratio->Draw(); //Nota Bene: Only draws statistical error bars on the ratio.  The systematic errors are in mcRatio.
+
+    mcRatio.SetLineColor(kRed);
+    mcRatio.SetLineWidth(::lineSize);
+    mcRatio.SetFillColorAlpha(kPink + 1, 0.4);
+    mcRatio.Draw("E2 SAME");
+
+    //Draw a flat line through the center of the MC
+    std::unique_ptr<TH1> straightLine(static_cast<TH1*>(mcRatio.Clone()));
+    straightLine->SetFillStyle(0);
+    straightLine->Draw("HISTSAME");
+
+    //Title for the whole plot
+    canvas.label(fiducialName, true);
+
+    canvas.overall.Print(outName.c_str());
+
+    return 0;
+  }
+}
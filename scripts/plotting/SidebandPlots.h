@@ -0,0 +1,46 @@
+//File: SidebandPlots.h
+//Brief: Data/MC ratio plots of one sideband at a time.  backgroundBreakdown and plotSideband draw one plot each.
+//       plotAllSidebands draws every plot for a pair of files after looking up everything they share only once.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_SIDEBANDPLOTS_H
+#define PLOTTING_SIDEBANDPLOTS_H
+
+//plotting includes
+#include "plotting/KeyIndex.h"
+
+//ROOT includes
+#include "TFile.h"
+
+//c++ includes
+#include <string>
+
+namespace plot
+{
+  //Throws std::runtime_error if file doesn't have POTUsed
+  double POTUsed(TFile& file);
+
+  //A file with what every plot of it needs to look up
+  struct Sample
+  {
+    Sample(TFile& sampleFile);
+
+    //For another handle on the same file, like in a worker process that can't share file's handle.
+    //Reuses sameFile's index and POT instead of looking them up again.
+    Sample(TFile& sampleFile, const Sample& sameFile);
+
+    TFile& file;
+    KeyIndex index;
+    double POT;
+  };
+
+  //Every MC histogram for a sideband stacked and compared to data.  MC is scaled to data's POT.
+  //Returns 0 on success.
+  int sidebandRatio(Sample& data, Sample& mc, const std::string& fiducialName, const std::string& sidebandName, const std::string& outName);
+
+  //Signal and each background for a sideband stacked and compared to data.  With isSelected, compares
+  //the selected MC events to the selected data instead.  Returns 0 on success.
+  int backgroundBreakdown(Sample& data, Sample& mc, const std::string& fiducialName, const std::string& sidebandName, const bool isSelected, const std::string& outName);
+}
+
+#endif //PLOTTING_SIDEBANDPLOTS_H
@@ -0,0 +1,518 @@
+//File: UniverseArray.cpp
+//Brief: An MnvH1D's or MnvH2D's CV and every universe of every error band unpacked into one contiguous block of doubles.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/UniverseArray.h"
+
+//c++ includes
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace
+{
+  void readHist(const TH1& hist, const int nCells, double* contents, double* sumw2)
+  {
+    for(int whichCell = 0; whichCell < nCells; ++whichCell) contents[whichCell] = hist.GetBinContent(whichCell);
+
+    //Without Sumw2(), TH1 treats every bin as if it was filled with weight 1
+    if(hist.GetSumw2N() > 0) std::copy(hist.GetSumw2()->GetArray(), hist.GetSumw2()->GetArray() + nCells, sumw2);
+    else std::copy(contents, contents + nCells, sumw2);
+  }
+
+  //TH1D and TH2D both keep their contents in a TArrayD, but not through a common base class
+  template <class HIST>
+  void writeHist(HIST& hist, const int nCells, const double* contents, const double* sumw2)
+  {
+    std::copy(contents, contents + nCells, hist.GetArray());
+    if(hist.GetSumw2N() == 0) hist.Sumw2();
+    std::copy(sumw2, sumw2 + nCells, hist.GetSumw2()->GetArray());
+  }
+
+  //These loops are the whole point of UniverseArray.  Keep them simple enough for the compiler to vectorize.
+  void add(double* __restrict__ lhs, const double* __restrict__ rhs, const size_t nValues)
+  {
+    for(size_t whichValue = 0; whichValue < nValues; ++whichValue) lhs[whichValue] += rhs[whichValue];
+  }
+
+  void scale(double* __restrict__ values, const double factor, const size_t nValues)
+  {
+    for(size_t whichValue = 0; whichValue < nValues; ++whichValue) values[whichValue] *= factor;
+  }
+
+  //Errors like TH1::Divide() without binomial errors: numerator and denominator are uncorrelated
+  void divide(double* __restrict__ contents, double* __restrict__ sumw2, const double* __restrict__ denContents, const double* __restrict__ denSumw2, const size_t nValues)
+  {
+    for(size_t whichValue = 0; whichValue < nValues; ++whichValue)
+    {
+      //Divide 0 by 1 instead of dividing by 0.  Even a ?: around the division stops vectorization.
+      const double notZero = (denContents[whichValue] != 0),
+                   inverse = notZero/(denContents[whichValue] + 1. - notZero),
+                   ratio = contents[whichValue]*inverse;
+      sumw2[whichValue] = (sumw2[whichValue] + denSumw2[whichValue]*ratio*ratio)*inverse*inverse;
+      contents[whichValue] = ratio;
+    }
+  }
+
+  //out += weight * deviation * deviation^T.  The inner loop is over one contiguous row so that it vectorizes.
+  void addOuterProduct(double* __restrict__ out, const double* __restrict__ deviation, const double weight, const int nCells)
+  {
+    for(int whichRow = 0; whichRow < nCells; ++whichRow)
+    {
+      const double scaled = weight*deviation[whichRow];
+      double* __restrict__ row = out + whichRow*nCells;
+      for(int whichCol = 0; whichCol < nCells; ++whichCol) row[whichCol] += scaled*deviation[whichCol];
+    }
+  }
+
+  //Just the diagonal of addOuterProduct()
+  void addSquares(double* __restrict__ out, const double* __restrict__ deviation, const double weight, const int nCells)
+  {
+    for(int whichCell = 0; whichCell < nCells; ++whichCell) out[whichCell] += weight*deviation[whichCell]*deviation[whichCell];
+  }
+
+  //out[row] += the sum of in's cells first through last in that row.  For a projection onto y.
+  void addRowSums(double* __restrict__ out, const double* __restrict__ in, const int nRows, const int rowSize, const int first, const int last)
+  {
+    for(int whichRow = 0; whichRow < nRows; ++whichRow)
+    {
+      const double* __restrict__ row = in + whichRow*rowSize;
+      double rowSum = 0;
+      for(int whichCell = first; whichCell <= last; ++whichCell) rowSum += row[whichCell];
+      out[whichRow] += rowSum;
+    }
+  }
+
+  //out += rows first through last of in.  For a projection onto x.
+  void addRows(double* __restrict__ out, const double* __restrict__ in, const int rowSize, const int first, const int last)
+  {
+    for(int whichRow = first; whichRow <= last; ++whichRow) add(out, in + whichRow*rowSize, rowSize);
+  }
+
+  //plot::sum() for MnvH1Ds or MnvH2Ds
+  template <class HIST>
+  plot::UniverseArray sumAny(const std::vector<HIST*>& hists, const double scale)
+  {
+    if(hists.empty()) throw std::runtime_error("Can't sum an empty list of histograms.");
+
+    plot::UniverseArray total(*hists.front());
+    if(hists.size() > 1)
+    {
+      //Reuse one buffer for everything else
+      plot::UniverseArray next(*hists[1]);
+      total += next;
+      for(auto hist = hists.begin() + 2; hist < hists.end(); ++hist)
+      {
+        next.read(**hist);
+        total += next;
+      }
+    }
+
+    if(scale != 1) total *= scale;
+    return total;
+  }
+
+  //1/cv, or 0 where cv is 0 like MnvH1D does for fractional errors
+  std::vector<double> inverseOf(const double* cv, const int nCells)
+  {
+    std::vector<double> inverse(nCells);
+    for(int whichCell = 0; whichCell < nCells; ++whichCell) inverse[whichCell] = (cv[whichCell] != 0)?1./cv[whichCell]:0;
+    return inverse;
+  }
+}
+
+namespace plot
+{
+  UniverseArray::UniverseArray(): fNCells(0), fNCellsX(0), fEntries(0)
+  {
+  }
+
+  UniverseArray::UniverseArray(const PlotUtils::MnvH1D& hist): UniverseArray()
+  {
+    read(hist);
+  }
+
+  UniverseArray::UniverseArray(const PlotUtils::MnvH2D& hist): UniverseArray()
+  {
+    read(hist);
+  }
+
+  template <class HIST>
+  std::vector<UniverseArray::Band> UniverseArray::bandsOf(const HIST& hist)
+  {
+    std::vector<Band> bands;
+    for(const auto& name: hist.GetVertErrorBandNames()) bands.push_back(Band{name, false, hist.GetVertErrorBand(name)->GetNHists(), hist.GetVertErrorBand(name)->GetUseSpreadError()});
+    for(const auto& name: hist.GetLatErrorBandNames()) bands.push_back(Band{name, true, hist.GetLatErrorBand(name)->GetNHists(), hist.GetLatErrorBand(name)->GetUseSpreadError()});
+    return bands;
+  }
+
+  void UniverseArray::read(const PlotUtils::MnvH1D& hist)
+  {
+    readAny(hist);
+  }
+
+  void UniverseArray::read(const PlotUtils::MnvH2D& hist)
+  {
+    readAny(hist);
+  }
+
+  template <class HIST>
+  void UniverseArray::readAny(const HIST& hist)
+  {
+    fNCells = hist.GetNcells();
+    fNCellsX = hist.GetNbinsX() + 2;
+    fBands = bandsOf(hist);
+    fEntries = hist.GetEntries();
+
+    size_t nColumns = 1;
+    for(const auto& band: fBands) nColumns += band.nUniverses;
+    fContents.resize(nColumns*fNCells);
+    fSumw2.resize(nColumns*fNCells);
+
+    ::readHist(hist, fNCells, fContents.data(), fSumw2.data());
+
+    size_t whichColumn = 1;
+    for(const auto& band: fBands)
+    {
+      const auto vert = band.isLateral?nullptr:hist.GetVertErrorBand(band.name);
+      const auto lat = band.isLateral?hist.GetLatErrorBand(band.name):nullptr;
+
+      for(unsigned int whichUniv = 0; whichUniv < band.nUniverses; ++whichUniv, ++whichColumn)
+      {
+        const auto univ = band.isLateral?lat->GetHist(whichUniv):vert->GetHist(whichUniv);
+        ::readHist(*univ, fNCells, fContents.data() + whichColumn*fNCells, fSumw2.data() + whichColumn*fNCells);
+      }
+    }
+  }
+
+  UniverseArray& UniverseArray::operator +=(const UniverseArray& rhs)
+  {
+    UniverseArray expanded;
+    const auto& toAdd = matchBands(rhs, expanded);
+    checkLayout(toAdd.fNCells, toAdd.fNCellsX, toAdd.fBands, "add");
+    ::add(fContents.data(), toAdd.fContents.data(), fContents.size());
+    ::add(fSumw2.data(), toAdd.fSumw2.data(), fSumw2.size());
+    fEntries += toAdd.fEntries;
+    return *this;
+  }
+
+  UniverseArray& UniverseArray::operator *=(const double factor)
+  {
+    ::scale(fContents.data(), factor, fContents.size());
+    ::scale(fSumw2.data(), factor*factor, fSumw2.size());
+    return *this;
+  }
+
+  UniverseArray& UniverseArray::operator /=(const UniverseArray& rhs)
+  {
+    UniverseArray expanded;
+    const auto& den = matchBands(rhs, expanded);
+    checkLayout(den.fNCells, den.fNCellsX, den.fBands, "divide");
+    ::divide(fContents.data(), fSumw2.data(), den.fContents.data(), den.fSumw2.data(), fContents.size());
+    return *this;
+  }
+
+  void UniverseArray::fill(PlotUtils::MnvH1D& hist) const
+  {
+    fillAny(hist);
+  }
+
+  void UniverseArray::fill(PlotUtils::MnvH2D& hist) const
+  {
+    fillAny(hist);
+  }
+
+  template <class HIST>
+  void UniverseArray::fillAny(HIST& hist) const
+  {
+    checkLayout(hist.GetNcells(), hist.GetNbinsX() + 2, bandsOf(hist), "fill " + std::string(hist.GetName()) + " with");
+
+    ::writeHist(hist, fNCells, fContents.data(), fSumw2.data());
+    hist.SetEntries(fEntries);
+
+    //Each error band is a histogram too, and its contents are the CV
+    size_t whichColumn = 1;
+    for(const auto& band: fBands)
+    {
+      const auto vert = band.isLateral?nullptr:hist.GetVertErrorBand(band.name);
+      const auto lat = band.isLateral?hist.GetLatErrorBand(band.name):nullptr;
+      if(band.isLateral) ::writeHist(*lat, fNCells, fContents.data(), fSumw2.data());
+      else ::writeHist(*vert, fNCells, fContents.data(), fSumw2.data());
+
+      for(unsigned int whichUniv = 0; whichUniv < band.nUniverses; ++whichUniv, ++whichColumn)
+      {
+        const auto univ = band.isLateral?lat->GetHist(whichUniv):vert->GetHist(whichUniv);
+        ::writeHist(*univ, fNCells, fContents.data() + whichColumn*fNCells, fSumw2.data() + whichColumn*fNCells);
+      }
+    }
+  }
+
+  PlotUtils::MnvH1D* UniverseArray::toMnvH1D(const PlotUtils::MnvH1D& like) const
+  {
+    auto hist = static_cast<PlotUtils::MnvH1D*>(like.Clone());
+    addBandsTo(*hist);
+    fill(*hist);
+    return hist;
+  }
+
+  PlotUtils::MnvH2D* UniverseArray::toMnvH2D(const PlotUtils::MnvH2D& like) const
+  {
+    auto hist = static_cast<PlotUtils::MnvH2D*>(like.Clone());
+    addBandsTo(*hist);
+    fill(*hist);
+    return hist;
+  }
+
+  //fill() sets the new bands' contents
+  template <class HIST>
+  void UniverseArray::addBandsTo(HIST& hist) const
+  {
+    const auto has = bandsOf(hist);
+    for(const auto& band: fBands)
+    {
+      if(std::any_of(has.begin(), has.end(), [&band](const Band& other) { return other.name == band.name && other.isLateral == band.isLateral; })) continue;
+
+      if(band.isLateral)
+      {
+        hist.AddLatErrorBand(band.name, band.nUniverses);
+        hist.GetLatErrorBand(band.name)->SetUseSpreadError(band.useSpreadError);
+      }
+      else
+      {
+        hist.AddVertErrorBand(band.name, band.nUniverses);
+        hist.GetVertErrorBand(band.name)->SetUseSpreadError(band.useSpreadError);
+      }
+    }
+  }
+
+  UniverseArray UniverseArray::project(const char axis, int first, int last) const
+  {
+    if(axis != 'x' && axis != 'y') throw std::runtime_error(std::string("Can't project onto axis ") + axis + ".  Only x and y are supported.");
+
+    const int nRows = fNCells/std::max(fNCellsX, 1),
+              nOtherCells = (axis == 'x')?nRows:fNCellsX;
+    if(last < first)
+    {
+      first = 0;
+      last = nOtherCells - 1;
+    }
+    first = std::max(first, 0);
+    last = std::min(last, nOtherCells - 1);
+
+    UniverseArray projection;
+    projection.fNCells = (axis == 'x')?fNCellsX:nRows;
+    projection.fNCellsX = projection.fNCells;
+    projection.fBands = fBands;
+    projection.fEntries = fEntries;
+    projection.fContents.assign(nColumns()*projection.fNCells, 0.);
+    projection.fSumw2.assign(nColumns()*projection.fNCells, 0.);
+
+    for(size_t whichColumn = 0; whichColumn < nColumns(); ++whichColumn)
+    {
+      const size_t from = whichColumn*fNCells, to = whichColumn*projection.fNCells;
+      if(axis == 'x')
+      {
+        ::addRows(projection.fContents.data() + to, fContents.data() + from, fNCellsX, first, last);
+        ::addRows(projection.fSumw2.data() + to, fSumw2.data() + from, fNCellsX, first, last);
+      }
+      else
+      {
+        ::addRowSums(projection.fContents.data() + to, fContents.data() + from, nRows, fNCellsX, first, last);
+        ::addRowSums(projection.fSumw2.data() + to, fSumw2.data() + from, nRows, fNCellsX, first, last);
+      }
+    }
+
+    return projection;
+  }
+
+  //Same as MnvVertErrorBand::CalcCovMx(): the average of each universe's deviation from the band's center
+  template <class FUNC>
+  void UniverseArray::forEachDeviation(FUNC&& use) const
+  {
+    std::vector<double> center(fNCells), deviation(fNCells);
+
+    size_t firstColumn = 1;
+    for(const auto& band: fBands)
+    {
+      if(band.nUniverses == 0) continue;
+
+      if(band.useSpreadError)
+      {
+        std::fill(center.begin(), center.end(), 0.);
+        for(size_t whichUniv = 0; whichUniv < band.nUniverses; ++whichUniv) ::add(center.data(), column(firstColumn + whichUniv), fNCells);
+        ::scale(center.data(), 1./band.nUniverses, fNCells);
+      }
+      else std::copy(column(0), column(0) + fNCells, center.begin());
+
+      for(size_t whichUniv = 0; whichUniv < band.nUniverses; ++whichUniv)
+      {
+        const double* univ = column(firstColumn + whichUniv);
+        for(int whichCell = 0; whichCell < fNCells; ++whichCell) deviation[whichCell] = univ[whichCell] - center[whichCell];
+        use(deviation.data(), 1./band.nUniverses, band);
+      }
+
+      firstColumn += band.nUniverses;
+    }
+  }
+
+  TMatrixD UniverseArray::covariance(const bool includeStat, const bool asFrac) const
+  {
+    const int nCells = fNCells;
+    TMatrixD cov(nCells, nCells);
+    double* out = cov.GetMatrixArray();
+
+    forEachDeviation([out, nCells](const double* deviation, const double weight, const Band& /*band*/)
+                     {
+                       ::addOuterProduct(out, deviation, weight, nCells);
+                     });
+
+    if(includeStat)
+    {
+      for(int whichCell = 0; whichCell < nCells; ++whichCell) out[whichCell*nCells + whichCell] += fSumw2[whichCell];
+    }
+
+    if(asFrac)
+    {
+      const auto inverse = ::inverseOf(column(0), nCells);
+      for(int whichRow = 0; whichRow < nCells; ++whichRow)
+      {
+        for(int whichCol = 0; whichCol < nCells; ++whichCol) out[whichRow*nCells + whichCol] *= inverse[whichRow]*inverse[whichCol];
+      }
+    }
+
+    return cov;
+  }
+
+  std::vector<double> UniverseArray::totalError(const bool includeStat, const bool asFrac) const
+  {
+    const int nCells = fNCells;
+    std::vector<double> errors(nCells, 0.);
+    double* out = errors.data();
+
+    forEachDeviation([out, nCells](const double* deviation, const double weight, const Band& /*band*/)
+                     {
+                       ::addSquares(out, deviation, weight, nCells);
+                     });
+
+    if(includeStat) ::add(out, fSumw2.data(), nCells);
+    for(auto& error: errors) error = std::sqrt(error);
+
+    if(asFrac)
+    {
+      const auto inverse = ::inverseOf(column(0), nCells);
+      for(int whichCell = 0; whichCell < nCells; ++whichCell) errors[whichCell] *= inverse[whichCell];
+    }
+
+    return errors;
+  }
+
+  std::map<std::string, std::vector<double>> UniverseArray::bandErrors(const bool asFrac) const
+  {
+    const int nCells = fNCells;
+    std::map<std::string, std::vector<double>> errors;
+
+    forEachDeviation([&errors, nCells](const double* deviation, const double weight, const Band& band)
+                     {
+                       auto& variance = errors[band.name];
+                       if(variance.empty()) variance.resize(nCells, 0.);
+                       ::addSquares(variance.data(), deviation, weight, nCells);
+                     });
+
+    const auto inverse = ::inverseOf(column(0), nCells);
+    for(auto& band: errors)
+    {
+      for(int whichCell = 0; whichCell < nCells; ++whichCell)
+      {
+        band.second[whichCell] = std::sqrt(band.second[whichCell]);
+        if(asFrac) band.second[whichCell] *= inverse[whichCell];
+      }
+    }
+
+    return errors;
+  }
+
+  std::vector<double> UniverseArray::statError(const bool asFrac) const
+  {
+    std::vector<double> errors(fNCells);
+    const auto inverse = ::inverseOf(column(0), fNCells);
+    for(int whichCell = 0; whichCell < fNCells; ++whichCell) errors[whichCell] = std::sqrt(fSumw2[whichCell])*(asFrac?inverse[whichCell]:1.);
+    return errors;
+  }
+
+  void UniverseArray::checkLayout(const int nCells, const int nCellsX, const std::vector<Band>& bands, const std::string& operation) const
+  {
+    if(nCells != fNCells || nCellsX != fNCellsX || bands != fBands)
+    {
+      throw std::runtime_error("Can't " + operation + " histograms with different bins, error bands, or numbers of universes.");
+    }
+  }
+
+  void UniverseArray::addMissingBands(const std::vector<Band>& bands)
+  {
+    //Where each band that this already has starts
+    std::map<std::pair<bool, std::string>, size_t> firstColumns;
+    size_t nextColumn = 1;
+    for(const auto& band: fBands)
+    {
+      firstColumns[std::make_pair(band.isLateral, band.name)] = nextColumn;
+      nextColumn += band.nUniverses;
+    }
+
+    auto merged = fBands;
+    for(const auto& band: bands)
+    {
+      if(!firstColumns.count(std::make_pair(band.isLateral, band.name))) merged.push_back(band);
+    }
+    if(merged.size() == fBands.size()) return;
+
+    //Same order that MnvH1D lists its bands in: vertical bands before lateral bands, and each sorted by name
+    std::sort(merged.begin(), merged.end(), [](const Band& lhs, const Band& rhs) { return std::tie(lhs.isLateral, lhs.name) < std::tie(rhs.isLateral, rhs.name); });
+
+    size_t nMergedColumns = 1;
+    for(const auto& band: merged) nMergedColumns += band.nUniverses;
+    std::vector<double> contents(nMergedColumns*fNCells), sumw2(nMergedColumns*fNCells);
+
+    std::copy(fContents.begin(), fContents.begin() + fNCells, contents.begin());
+    std::copy(fSumw2.begin(), fSumw2.begin() + fNCells, sumw2.begin());
+    size_t whichColumn = 1;
+    for(const auto& band: merged)
+    {
+      const auto found = firstColumns.find(std::make_pair(band.isLateral, band.name));
+      for(unsigned int whichUniv = 0; whichUniv < band.nUniverses; ++whichUniv, ++whichColumn)
+      {
+        const size_t from = (found == firstColumns.end())?0:(found->second + whichUniv)*fNCells;
+        std::copy(fContents.begin() + from, fContents.begin() + from + fNCells, contents.begin() + whichColumn*fNCells);
+        std::copy(fSumw2.begin() + from, fSumw2.begin() + from + fNCells, sumw2.begin() + whichColumn*fNCells);
+      }
+    }
+
+    fBands = merged;
+    fContents.swap(contents);
+    fSumw2.swap(sumw2);
+  }
+
+  //Bands are only added when the bins are the same so that checkLayout() still reports different bins
+  const UniverseArray& UniverseArray::matchBands(const UniverseArray& rhs, UniverseArray& expanded)
+  {
+    if(rhs.fBands == fBands || rhs.fNCells != fNCells || rhs.fNCellsX != fNCellsX) return rhs;
+
+    addMissingBands(rhs.fBands);
+    if(rhs.fBands == fBands) return rhs;
+
+    expanded = rhs;
+    expanded.addMissingBands(fBands);
+    return expanded;
+  }
+
+  UniverseArray sum(const std::vector<PlotUtils::MnvH1D*>& hists, const double scale)
+  {
+    return ::sumAny(hists, scale);
+  }
+
+  UniverseArray sum(const std::vector<PlotUtils::MnvH2D*>& hists, const double scale)
+  {
+    return ::sumAny(hists, scale);
+  }
+}
@@ -0,0 +1,140 @@
+//File: UniverseArray.h
+//Brief: An MnvH1D's or MnvH2D's CV and every universe of every error band unpacked into one contiguous block of doubles.
+//       Adding, scaling, and dividing MnvH1Ds one TH1 at a time walks hundreds of separate histograms for every
+//       operation.  A UniverseArray does the same arithmetic as a few flat loops over all universes at once that
+//       the compiler can vectorize.  Convert to a UniverseArray once, do all of the arithmetic, and convert back
+//       to an MnvH1D once at the end.  An MnvH2D's cells are in the same order as TH2's global bins, so the same
+//       loops work on it, and project() makes every universe's projection at once.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#ifndef PLOTTING_UNIVERSEARRAY_H
+#define PLOTTING_UNIVERSEARRAY_H
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TMatrixD.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+namespace plot
+{
+  class UniverseArray
+  {
+    public:
+      //Copies hist's CV and every universe of every error band
+      UniverseArray(const PlotUtils::MnvH1D& hist);
+      UniverseArray(const PlotUtils::MnvH2D& hist);
+
+      //Replace everything with hist's contents.  Reuses memory that's already allocated.
+      void read(const PlotUtils::MnvH1D& hist);
+      void read(const PlotUtils::MnvH2D& hist);
+
+      //Same as MnvH1D::Add(), MnvH1D::Scale(), and MnvH1D::Divide() with statistical errors like TH1's.
+      //Bins divided by 0 are 0 like in TH1::Divide().  Like MnvH1D::AddMissingErrorBandsAndFillWithCV(), an
+      //error band that only one side has is added to the other with every universe set to that side's CV.
+      //Throw std::runtime_error unless rhs has the same bins and the same universes in the bands both have.
+      UniverseArray& operator +=(const UniverseArray& rhs);
+      UniverseArray& operator *=(const double scale);
+      UniverseArray& operator /=(const UniverseArray& rhs);
+
+      //Overwrite hist's CV and universes with this.  Throws std::runtime_error unless hist
+      //has the same bins, error bands, and universes as this.
+      void fill(PlotUtils::MnvH1D& hist) const;
+      void fill(PlotUtils::MnvH2D& hist) const;
+
+      //A copy of like with this's contents.  The copy gets any error bands that only this has.  Caller owns it.
+      PlotUtils::MnvH1D* toMnvH1D(const PlotUtils::MnvH1D& like) const;
+      PlotUtils::MnvH2D* toMnvH2D(const PlotUtils::MnvH2D& like) const;
+
+      //Every universe of a 2D histogram projected onto axis 'x' or 'y' like MnvH2D::ProjectionX() in one pass.
+      //Only bins first through last of the other axis are summed.  last < first sums every bin of the other
+      //axis including underflow and overflow like ProjectionX()'s defaults.  Throws std::runtime_error for any
+      //other axis.
+      UniverseArray project(const char axis, int first = 0, int last = -1) const;
+
+      //Covariance of every pair of cells from the spread of every error band's universes, like
+      //MnvH1D::GetTotalErrorMatrix().  Adds statistical errors to the diagonal with includeStat.
+      //Divided by the CV in both cells with asFrac.  Each universe is visited once, so dividing first and
+      //calling this on the ratio propagates the errors with every correlation between bins and error bands.
+      TMatrixD covariance(const bool includeStat = true, const bool asFrac = false) const;
+
+      //Square root of covariance()'s diagonal without building the rest of the matrix
+      std::vector<double> totalError(const bool includeStat = true, const bool asFrac = false) const;
+
+      //totalError() from each error band on its own, all in one pass over the universes
+      std::map<std::string, std::vector<double>> bandErrors(const bool asFrac = false) const;
+
+      //Just the statistical part of totalError()
+      std::vector<double> statError(const bool asFrac = false) const;
+
+      //The CV is column 0.  Then come each error band's universes in the order MnvH1D lists the bands.
+      inline int nCells() const { return fNCells; }
+      inline int nCellsX() const { return fNCellsX; }
+      inline size_t nColumns() const { return fContents.size()/std::max(fNCells, 1); }
+      inline const double* column(const size_t whichColumn) const { return fContents.data() + whichColumn*fNCells; }
+
+    private:
+      struct Band
+      {
+        std::string name;
+        bool isLateral;
+        unsigned int nUniverses;
+        bool useSpreadError; //Universes spread around their mean instead of the CV
+
+        inline bool operator ==(const Band& rhs) const { return name == rhs.name && isLateral == rhs.isLateral && nUniverses == rhs.nUniverses; }
+      };
+
+      int fNCells; //Bins including underflow and overflow
+      int fNCellsX; //Cells in each row along the x axis.  fNCells for a 1D histogram.
+      std::vector<Band> fBands;
+      double fEntries;
+
+      //[column*fNCells + cell]
+      std::vector<double> fContents;
+      std::vector<double> fSumw2;
+
+      //Only for project()
+      UniverseArray();
+
+      //MnvH1D and MnvH2D have the same error band interface
+      template <class HIST>
+      static std::vector<Band> bandsOf(const HIST& hist);
+
+      template <class HIST>
+      void readAny(const HIST& hist);
+
+      template <class HIST>
+      void fillAny(HIST& hist) const;
+
+      void checkLayout(const int nCells, const int nCellsX, const std::vector<Band>& bands, const std::string& operation) const;
+
+      //Adds each of bands that this doesn't have with every universe set to the CV
+      void addMissingBands(const std::vector<Band>& bands);
+
+      //Gives this every band rhs has.  Returns rhs if it already has every band this has.  Otherwise, returns
+      //expanded set to a copy of rhs with the rest.
+      const UniverseArray& matchBands(const UniverseArray& rhs, UniverseArray& expanded);
+
+      template <class HIST>
+      void addBandsTo(HIST& hist) const;
+
+      //Calls use(deviation, weight, band) with each universe minus its band's center
+      template <class FUNC>
+      void forEachDeviation(FUNC&& use) const;
+  };
+
+  //Sum of hists multiplied by scale.  Scaling the sum once is cheaper than scaling each histogram.
+  //Has every error band that any of hists has like operator +=().  Throws std::runtime_error if hists is
+  //empty or they have different bins.
+  UniverseArray sum(const std::vector<PlotUtils::MnvH1D*>& hists, const double scale = 1);
+  UniverseArray sum(const std::vector<PlotUtils::MnvH2D*>& hists, const double scale = 1);
+}
+
+#endif //PLOTTING_UNIVERSEARRAY_H
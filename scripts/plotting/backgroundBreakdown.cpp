@@ -0,0 +1,52 @@
+//File: backgroundBreakdown.cpp
+//Brief: Draws data and MC histograms on the same canvas with a ratio of Data/MC
+//       on a canvas below for a sideband.  The MC is stacked by background category.
+//       plotAllSidebands draws this for every sideband at once.
+//Usage: backgroundBreakdown data.root mc.root sidebandName [isSelected]
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/Helpers.h"
+#include "plotting/SidebandPlots.h"
+
+//c++ includes
+#include <iostream>
+#include <string>
+
+int backgroundBreakdown(const std::string& dataFileName, const std::string& mcFileName, const std::string& sidebandName, const bool isSelected = false)
+{
+  auto dataFile = plot::giveMeFileOrGiveMeDeath(dataFileName),
+       mcFile   = plot::giveMeFileOrGiveMeDeath(mcFileName);
+
+  plot::Sample data(*dataFile), mc(*mcFile);
+
+  const std::string fiducialName = "Tracker";
+  return plot::backgroundBreakdown(data, mc, fiducialName, sidebandName, isSelected, fiducialName + sidebandName + "DataMCRatio.png"); //TODO: Include file name here
+}
+
+#ifdef BUILD_STANDALONE
+//ROOT includes
+#include "TROOT.h"
+
+int main(const int argc, const char** argv)
+{
+  if(argc < 4 || argc > 5)
+  {
+    std::cerr << "USAGE: " << argv[0] << " data.root mc.root sidebandName [isSelected]\n";
+    return 2;
+  }
+
+  gROOT->SetBatch(true);
+
+  try
+  {
+    const std::string isSelected = (argc > 4)?argv[4]:"false";
+    return backgroundBreakdown(argv[1], argv[2], argv[3], isSelected == "true" || isSelected == "1");
+  }
+  catch(const std::runtime_error& e)
+  {
+    std::cerr << e.what() << "\n";
+    return 3;
+  }
+}
+#endif //BUILD_STANDALONE
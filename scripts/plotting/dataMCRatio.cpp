@@ -0,0 +1,163 @@
+//File: dataMCRatio.cpp
+//Brief: Draws data and MC histograms on the same canvas with a ratio of Data/MC
+//       on a canvas below.
+//Usage: dataMCRatio data.root mc.root
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/Helpers.h"
+#include "plotting/UniverseArray.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvColors.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TStyle.h"
+#include "TLegend.h"
+
+//c++ includes
+#include <iostream>
+#include <string>
+#include <regex>
+
+//I hate global variables, but it's after 10PM...
+const int lineSize = 2;
+const double maxMC = 2; //Maximum across all plots I want to compare
+const double minRatio = 0.5, maxRatio = 1.9;
+
+int dataMCRatio(const std::string& dataFileName, const std::string& mcFileName)
+{
+  gStyle->SetOptStat(0);
+  gStyle->SetOptTitle(0); //I'll draw it myself
+  gStyle->SetTitleSize(0.08, "pad");
+
+  auto dataFile = plot::giveMeFileOrGiveMeDeath(dataFileName),
+       mcFile   = plot::giveMeFileOrGiveMeDeath(mcFileName);
+
+  const std::string var = "EDeps", anaName = "Tracker_Neutron_Detection",
+                    dataName = anaName + "_Data" + var;
+  const std::regex find(anaName + R"(__(.*))" + var);
+
+  auto mcStack = plot::selectStack(*mcFile, find);
+  auto dataHist = dynamic_cast<TH1D*>(dataFile->Get(dataName.c_str()));
+  if(!dataHist)
+  {
+    std::cerr << "Failed to find a histogram named " << dataName << "\n";
+    return 1;
+  }
+
+  //Set histogram styles
+  plot::applyColors(*mcStack.GetHists(), MnvColors::GetColors(MnvColors::kOkabeItoDarkPalette), lineSize, false);
+
+  plot::RatioCanvas canvas("Data/MC for " + var);
+  auto& top = canvas.top;
+  auto& bottom = canvas.bottom;
+
+  //Data with stacked MC
+  top.cd();
+
+  auto mcTotal = static_cast<TH1*>(mcStack.GetStack()->Last());
+  mcTotal->SetTitle("MnvGENIEv1");
+
+  mcTotal->GetYaxis()->SetTitle("candidates / event"); //dataHist->GetYaxis()->GetTitle()); //TODO: I had the axes backwards in the original plo
+  canvas.styleTop(*mcTotal);
+
+  mcTotal->SetLineColor(kRed);
+  mcTotal->SetFillColorAlpha(kPink + 1, 0.4);
+  mcTotal->SetMaximum(maxMC);
+  mcTotal->Draw("E2"); //Draw the error bars
+
+  mcStack.Draw("HISTnostackSAME");
+  auto axes = mcStack.GetHistogram(); //N.B.: GetHistogram() would have returned nullptr had I called it before Draw()!
+
+  dataHist->SetLineColor(1);
+  dataHist->SetLineWidth(lineSize);
+  dataHist->SetMarkerStyle(20); //Resizeable closed circle
+  dataHist->SetMarkerColor(1);
+  dataHist->SetMarkerSize(0.7);
+  dataHist->SetTitle("Data");
+  dataHist->Draw("SAME");
+
+  auto legend = top.BuildLegend(0.5, 0.4, 0.9, 0.9);
+
+  //Drawing the thing that I don't want in the legend AFTER
+  //building the legend.  What a dirty hack!
+  auto lineOnly = static_cast<TH1*>(mcTotal->Clone());
+  lineOnly->SetFillStyle(0);
+  lineOnly->Draw("HISTSAME"); //Draw the line
+
+  //Data/MC ratio panel
+  bottom.cd();
+  //The stack only needed CVs, but the ratio's systematics need every universe.  Dividing universe by
+  //universe carries the MC's systematics through the ratio with every correlation between bins.
+  const auto mcHists = plot::select(*mcFile, find, 1);
+  if(mcHists.empty())
+  {
+    std::cerr << "Failed to find any MC histograms for " << var << " in " << mcFileName << "\n";
+    return 1;
+  }
+  PlotUtils::MnvH1D dataWithBands(*dataHist);
+  dataWithBands.AddMissingErrorBandsAndFillWithCV(*mcHists.front());
+
+  plot::UniverseArray ratioUnivs(dataWithBands);
+  ratioUnivs /= plot::sum(mcHists);
+  auto ratio = ratioUnivs.toMnvH1D(dataWithBands);
+
+  //Now fill mcRatio with 1 for bin content and the ratio's fractional systematic error
+  auto mcRatio = static_cast<TH1D*>(ratio->GetCVHistoWithStatError().Clone());
+  plot::fillRatioBand(*mcRatio, ratioUnivs.totalError(false, true));
+
+  ratio->SetTitle("");
+  ratio->SetLineWidth(lineSize);
+  canvas.styleRatio(*ratio);
+  ratio->GetXaxis()->SetTitle("energy deposits [MeV]"); //dataHist->GetXaxis()->GetTitle()); //TODO: I had the axes backwards in the original plot
+
+  ratio->SetMinimum(minRatio);
+  ratio->SetMaximum(maxRatio);
+  ratio->Draw();
+
+  mcRatio->SetLineColor(kRed);
+  mcRatio->SetLineWidth(lineSize);
+  mcRatio->SetFillColorAlpha(kPink + 1, 0.4);
+  mcRatio->Draw("E2SAME");
+
+  //Draw a flat line through the center of the MC
+  auto straightLine = static_cast<TH1*>(mcRatio->Clone());
+  straightLine->SetFillStyle(0);
+  straightLine->Draw("HISTSAME");
+
+  //Title for the whole plot
+  canvas.label("Tracker", true); //TODO: Get this from the file name?
+
+  canvas.overall.Print((var + "DataMCRatio.png").c_str()); //TODO: Include file name here
+
+  return 0;
+}
+
+#ifdef BUILD_STANDALONE
+//ROOT includes
+#include "TROOT.h"
+
+int main(const int argc, const char** argv)
+{
+  if(argc != 3)
+  {
+    std::cerr << "USAGE: " << argv[0] << " data.root mc.root\n";
+    return 2;
+  }
+
+  gROOT->SetBatch(true);
+
+  try
+  {
+    return dataMCRatio(argv[1], argv[2]);
+  }
+  catch(const std::runtime_error& e)
+  {
+    std::cerr << e.what() << "\n";
+    return 3;
+  }
+}
+#endif //BUILD_STANDALONE
@@ -2,20 +2,20 @@
 //Brief: Draws data and MC histograms on the same canvas with a ratio of Data/MC
 //       on a canvas below.  Accepts any number of additional MC predictions and
 //       and draws their ratios too.  This is my approximation to figure 5 of https://arxiv.org/pdf/1901.04892.pdf
+//Usage: edepsWithRatioFromLEPaper data.root mc.root [otherMC.root...]
 //Author: Andrew Olivier aolivier@ur.rochester.edu
 
+//plotting includes
+#include "plotting/Helpers.h"
+
 //PlotUtils includes
 #include "PlotUtils/MnvH1D.h"
 #include "PlotUtils/MnvColors.h"
 
 //ROOT includes
 #include "TFile.h"
-#include "TKey.h"
 #include "TStyle.h"
-#include "TCanvas.h"
-#include "THStack.h"
 #include "TLegend.h"
-#include "TPaveText.h"
 
 //c++ includes
 #include <iostream>
@@ -27,59 +27,20 @@ const int lineSize = 2;
 const double maxMC = 2; //Maximum across all plots I want to compare
 const double minRatio = 0.5, maxRatio = 1.9;
 
-THStack select(TFile& file, const std::regex& match)
-{
-  THStack found;
-
-  for(auto key: *file.GetListOfKeys())
-  {
-    if(std::regex_match(key->GetName(), match))
-    {
-      auto hist = dynamic_cast<PlotUtils::MnvH1D*>(static_cast<TKey*>(key)->ReadObj());
-      if(hist)
-      {
-        found.Add(static_cast<TH1D*>(hist->GetCVHistoWithError().Clone()));
-      }
-    }
-  }
-
-  return found;
-}
-
-TFile* giveMeFileOrGiveMeDeath(const std::string& fileName)
-{
-  auto file = TFile::Open(fileName.c_str());
-  if(!file) throw std::runtime_error("Failed to open a file named " + fileName);
-  return file;
-}
-
-void applyColors(TList& hists, const std::vector<int>& colors)
-{
-  for(int whichHist = 0; whichHist < hists.GetEntries(); ++whichHist)
-  {
-    auto& hist = dynamic_cast<TH1&>(*hists.At(whichHist));
-    hist.SetLineColor(colors.at(whichHist));
-    hist.SetLineWidth(lineSize);
-    //hist.SetFillColor(colors.at(whichHist)); //Use only without nostack (Yes, that's a double negative)
-  }
-}
-
-template <class ...ARGS>
-int edepsWithRatioFromLEPaper(const std::string& dataFileName, const std::string& mcFileName, const ARGS&... otherMCFileNames)
+int edepsWithRatioFromLEPaper(const std::string& dataFileName, const std::string& mcFileName, const std::vector<std::string>& otherMCFileNames)
 {
   gStyle->SetOptStat(0);
   gStyle->SetOptTitle(0); //I'll draw it myself
   gStyle->SetTitleSize(0.08, "pad");
 
-  auto dataFile = giveMeFileOrGiveMeDeath(dataFileName),
-       mcFile   = giveMeFileOrGiveMeDeath(mcFileName);
-  //std::vector<TFile*> otherMCFiles = {giveMeFileOrGiveMeDeath(otherMCFileName)...};
+  auto dataFile = plot::giveMeFileOrGiveMeDeath(dataFileName),
+       mcFile   = plot::giveMeFileOrGiveMeDeath(mcFileName);
 
   const std::string var = "EDeps", anaName = "Tracker_Neutron_Detection",
                     dataName = anaName + "_Data" + var;
   const std::regex find(anaName + R"(__(.*))" + var);
 
-  auto mcStack = select(*mcFile, find);
+  auto mcStack = plot::selectStack(*mcFile, find);
   auto dataHist = dynamic_cast<TH1D*>(dataFile->Get(dataName.c_str()));
   if(!dataHist)
   {
@@ -87,32 +48,21 @@ int edepsWithRatioFromLEPaper(const std::string& dataFileName, const std::string
     return 1;
   }
 
-  std::vector<TFile*> otherMCFiles = {giveMeFileOrGiveMeDeath(otherMCFileNames)...};
   std::vector<THStack> otherMCStacks;
-  for(const auto& file: otherMCFiles)
+  for(const auto& fileName: otherMCFileNames)
   {
-    auto stack = select(*file, find);
+    auto file = plot::giveMeFileOrGiveMeDeath(fileName);
+    auto stack = plot::selectStack(*file, find);
     stack.SetName(file->GetName());
     otherMCStacks.push_back(stack);
   }
 
   //Set histogram styles
-  applyColors(*mcStack.GetHists(), MnvColors::GetColors(MnvColors::kOkabeItoDarkPalette));
-
-  //Set up a Canvas split in 2.  The bottom canvas really overlaps the top by margin
-  //to avoid drawing the x axis twice.
-  TCanvas overall(("Data/MC for " + var).c_str());
-
-  //Turns out that when you create a TPad while there's a TCanvas,
-  //the canvas automatically becomes the parent of that TPad.
-  const double bottomFraction = 0.2, margin = 0.078; //margin was tuned by hand
-  TPad top("Overlay", "Overlay", 0, bottomFraction, 1, 1),
-       bottom("Ratio", "Ratio", 0, 0, 1, bottomFraction + margin);
-  //Thou shalt Draw() new TPads lest they be blank!
-  top.Draw();
-  bottom.Draw();
+  plot::applyColors(*mcStack.GetHists(), MnvColors::GetColors(MnvColors::kOkabeItoDarkPalette), lineSize, false);
 
-  const double labelSize = 0.15;
+  plot::RatioCanvas canvas("Data/MC for " + var);
+  auto& top = canvas.top;
+  auto& bottom = canvas.bottom;
 
   //Data with stacked MC
   top.cd();
@@ -121,9 +71,7 @@ int edepsWithRatioFromLEPaper(const std::string& dataFileName, const std::string
   mcTotal->SetTitle("MnvGENIEv1");
 
   mcTotal->GetYaxis()->SetTitle("candidates / event"); //dataHist->GetYaxis()->GetTitle()); //TODO: I had the axes backwards in the original plo
-  mcTotal->GetYaxis()->SetLabelSize(labelSize * (bottomFraction + margin));
-  mcTotal->GetYaxis()->SetTitleSize(0.06); //TODO: How to guess what these are?
-  mcTotal->GetYaxis()->SetTitleOffset(0.6);
+  canvas.styleTop(*mcTotal);
 
   mcTotal->SetLineColor(kRed);
   mcTotal->SetFillColorAlpha(kPink + 1, 0.4);
@@ -151,26 +99,14 @@ int edepsWithRatioFromLEPaper(const std::string& dataFileName, const std::string
 
   //Data/MC ratio panel
   bottom.cd();
-  bottom.SetTopMargin(0);
-  bottom.SetBottomMargin(0.3);
   auto ratio = static_cast<PlotUtils::MnvH1D*>(dataHist->Clone()),
        mcRatio = static_cast<PlotUtils::MnvH1D*>(mcStack.GetStack()->Last()->Clone());
   ratio->Divide(ratio, mcRatio);
 
   ratio->SetTitle("data");
   ratio->SetLineWidth(lineSize);
-  ratio->SetTitleSize(0);
-
-  ratio->GetYaxis()->SetTitle("Data / MC");
-  ratio->GetYaxis()->SetLabelSize(labelSize);
-  ratio->GetYaxis()->SetTitleSize(0.16);
-  ratio->GetYaxis()->SetTitleOffset(0.2);
-  ratio->GetYaxis()->SetNdivisions(505); //5 minor divisions between 5 major divisions
-
-  ratio->GetXaxis()->SetTitleSize(0.16);
-  ratio->GetXaxis()->SetTitleOffset(0.9);
+  canvas.styleRatio(*ratio);
   ratio->GetXaxis()->SetTitle("energy deposits [MeV]"); //dataHist->GetXaxis()->GetTitle()); //TODO: I had the axes backwards in the original plot
-  ratio->GetXaxis()->SetLabelSize(labelSize);
 
   ratio->SetMinimum(minRatio);
   ratio->SetMaximum(maxRatio);
@@ -219,23 +155,35 @@ int edepsWithRatioFromLEPaper(const std::string& dataFileName, const std::string
   //TODO: Do uncertainty propagation correctly.  Looks like I'm assuming data and MC are uncorrelated for now which is roughly true.
 
   //Title for the whole plot
-  top.cd();
-  TPaveText title(0.3, 0.91, 0.7, 1.0, "nbNDC"); //no border
-  title.SetFillStyle(0);
-  title.SetLineColor(0);
-  title.AddText("Tracker"); //TODO: Get this from the file name?
-  title.Draw();
-
-  //MINERvA Preliminary
-  TPaveText prelim(0.12, 0.75, 0.47, 0.89, "nbNDC"); //no border
-  prelim.SetFillStyle(0);
-  prelim.SetLineColor(0);
-  prelim.SetTextColor(kBlue);
-  prelim.AddText("MINERvA Work in Progress"); //Preliminary");
-  prelim.AddText("Stat. Errors Only");
-  prelim.Draw();
-
-  overall.Print((var + "DataMCRatio.png").c_str()); //TODO: Include file name here
+  canvas.label("Tracker"); //TODO: Get this from the file name?
+
+  canvas.overall.Print((var + "DataMCRatio.png").c_str()); //TODO: Include file name here
 
   return 0;
 }
+
+#ifdef BUILD_STANDALONE
+//ROOT includes
+#include "TROOT.h"
+
+int main(const int argc, const char** argv)
+{
+  if(argc < 3)
+  {
+    std::cerr << "USAGE: " << argv[0] << " data.root mc.root [otherMC.root...]\n";
+    return 2;
+  }
+
+  gROOT->SetBatch(true);
+
+  try
+  {
+    return edepsWithRatioFromLEPaper(argv[1], argv[2], std::vector<std::string>(argv + 3, argv + argc));
+  }
+  catch(const std::runtime_error& e)
+  {
+    std::cerr << e.what() << "\n";
+    return 3;
+  }
+}
+#endif //BUILD_STANDALONE
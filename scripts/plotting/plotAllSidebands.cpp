@@ -0,0 +1,189 @@
+//File: plotAllSidebands.cpp
+//Brief: Draws every sideband plot that plotSideband and backgroundBreakdown can make for one data file and one MC
+//       file: a data/MC ratio and a background breakdown for every fiducial volume and sideband, and a breakdown
+//       of selected events too when there are selected histograms.  The files are opened, indexed, and have
+//       their POT looked up only once.  The plots are split between nWorkers processes because ROOT graphics
+//       isn't thread-safe.  Each worker opens its own handles on the files, but it reuses the index and POT.
+//       Defaults to one worker per core.
+//Usage: plotAllSidebands data.root mc.root [nWorkers]
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/Helpers.h"
+#include "plotting/SidebandPlots.h"
+
+//ROOT includes
+#include "TROOT.h"
+
+//c++ includes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <regex>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
+
+//POSIX includes
+#include <unistd.h>
+#include <sys/wait.h>
+
+namespace
+{
+  struct Plot
+  {
+    enum Kind { ratio, breakdown, selectedBreakdown };
+
+    std::string fiducialName;
+    std::string sidebandName;
+    Kind kind;
+  };
+
+  //Every fiducial volume and sideband in the MC file that has data to compare to.
+  //Fiducial volume names don't have underscores in them.
+  std::vector<Plot> findPlots(const plot::Sample& data, const plot::Sample& mc)
+  {
+    const std::regex truthSignal(R"(([^_]+)_(.+)_TruthSignal)"),
+                     selectedSignal(R"(([^_]+)_(.+)_SelectedMCEvents)");
+    std::vector<Plot> plots;
+
+    for(const auto& key: mc.index.match(std::regex(".*")))
+    {
+      std::smatch found;
+      if(std::regex_match(key.name, found, truthSignal) && data.index.find(found[1].str() + "_" + found[2].str() + "_Data"))
+      {
+        plots.push_back(Plot{found[1], found[2], Plot::ratio});
+        plots.push_back(Plot{found[1], found[2], Plot::breakdown});
+      }
+      else if(std::regex_match(key.name, found, selectedSignal) && data.index.find(found[1].str() + "_" + found[2].str() + "_Signal"))
+      {
+        plots.push_back(Plot{found[1], found[2], Plot::selectedBreakdown});
+      }
+    }
+
+    return plots;
+  }
+
+  //Returns 0 on success
+  int draw(const Plot& toDraw, plot::Sample& data, plot::Sample& mc)
+  {
+    const std::string prefix = toDraw.fiducialName + toDraw.sidebandName;
+
+    try
+    {
+      switch(toDraw.kind)
+      {
+        case Plot::ratio: return plot::sidebandRatio(data, mc, toDraw.fiducialName, toDraw.sidebandName, prefix + "DataMCRatio.png");
+        case Plot::breakdown: return plot::backgroundBreakdown(data, mc, toDraw.fiducialName, toDraw.sidebandName, false, prefix + "BackgroundBreakdown.png");
+        case Plot::selectedBreakdown: return plot::backgroundBreakdown(data, mc, toDraw.fiducialName, toDraw.sidebandName, true, prefix + "SelectedBackgroundBreakdown.png");
+      }
+    }
+    catch(const std::runtime_error& e)
+    {
+      std::cerr << e.what() << "\n";
+    }
+
+    return 1;
+  }
+
+  //Draw every stride-th plot starting with first.  Returns how many failed.
+  int drawShare(const std::vector<Plot>& plots, const size_t first, const size_t stride, plot::Sample& data, plot::Sample& mc)
+  {
+    int nFailed = 0;
+    for(size_t whichPlot = first; whichPlot < plots.size(); whichPlot += stride)
+    {
+      if(draw(plots[whichPlot], data, mc) != 0) ++nFailed;
+    }
+    return nFailed;
+  }
+}
+
+int plotAllSidebands(const std::string& dataFileName, const std::string& mcFileName, const int nWorkers)
+{
+  auto dataFile = plot::giveMeFileOrGiveMeDeath(dataFileName),
+       mcFile   = plot::giveMeFileOrGiveMeDeath(mcFileName);
+
+  plot::Sample data(*dataFile), mc(*mcFile);
+
+  const auto plots = ::findPlots(data, mc);
+  if(plots.empty())
+  {
+    std::cerr << "Didn't find any sidebands in " << mcFileName << " with data in " << dataFileName << " to compare to.\n";
+    return 1;
+  }
+
+  const size_t stride = std::max(1, std::min<int>(nWorkers, plots.size()));
+  int nFailed = 0;
+
+  if(stride == 1) nFailed = ::drawShare(plots, 0, 1, data, mc);
+  else
+  {
+    //Forked processes would share the parent's file offsets, so each worker opens the files again.
+    std::fflush(nullptr); //Or every worker prints whatever hasn't been printed yet again
+    std::vector<pid_t> workers;
+    for(size_t whichWorker = 0; whichWorker < stride; ++whichWorker)
+    {
+      const pid_t pid = fork();
+      if(pid == 0)
+      {
+        std::unique_ptr<TFile> workerDataFile(TFile::Open(dataFileName.c_str())),
+                               workerMCFile(TFile::Open(mcFileName.c_str()));
+        if(!workerDataFile || !workerMCFile) _exit(255);
+
+        plot::Sample workerData(*workerDataFile, data), workerMC(*workerMCFile, mc);
+        _exit(std::min(::drawShare(plots, whichWorker, stride, workerData, workerMC), 254)); //Don't clean up anything the parent still needs
+      }
+      else if(pid < 0)
+      {
+        std::perror("Failed to start a worker process.  Drawing its plots here instead");
+        nFailed += ::drawShare(plots, whichWorker, stride, data, mc);
+      }
+      else workers.push_back(pid);
+    }
+
+    for(const auto pid: workers)
+    {
+      int status = 0;
+      if(waitpid(pid, &status, 0) < 0 || !WIFEXITED(status))
+      {
+        std::cerr << "Worker process " << pid << " crashed.  Some of its plots are missing.\n";
+        ++nFailed;
+      }
+      else if(WEXITSTATUS(status) == 255)
+      {
+        std::cerr << "Worker process " << pid << " couldn't open " << dataFileName << " or " << mcFileName << ".\n";
+        ++nFailed;
+      }
+      else nFailed += WEXITSTATUS(status);
+    }
+  }
+
+  if(nFailed > 0) std::cerr << nFailed << " of " << plots.size() << " plots failed.\n";
+  else std::cout << "Drew " << plots.size() << " plots.\n";
+
+  return (nFailed > 0)?1:0;
+}
+
+#ifdef BUILD_STANDALONE
+int main(const int argc, const char** argv)
+{
+  if(argc < 3 || argc > 4)
+  {
+    std::cerr << "USAGE: " << argv[0] << " data.root mc.root [nWorkers]\n";
+    return 2;
+  }
+
+  gROOT->SetBatch(true);
+
+  try
+  {
+    const int nWorkers = (argc > 3)?std::stoi(argv[3]):sysconf(_SC_NPROCESSORS_ONLN);
+    return plotAllSidebands(argv[1], argv[2], nWorkers);
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr << e.what() << "\n";
+    return 3;
+  }
+}
+#endif //BUILD_STANDALONE
@@ -0,0 +1,235 @@
+//File: plotEfficiencyAndProcesses.cpp
+//Brief: Plot a 1D efficiency, then a 2D efficiency and a breakdown of its numerator by interaction process for
+//       every variable with process numerators in a 2D efficiency file.  Each MnvH2D is unpacked once into a
+//       ProjectionCache, so projecting it again for another plot is free, and the 2D efficiency divides every
+//       universe at once.  Plots are named after each variable, like Tracker_Efficiency_processBreakdown.png.
+//Usage: plotEfficiencyAndProcesses [oneDFile.root twoDFile.root]
+//       Defaults to MuonPT_manyCandsMC.root and MuonEfficiencyStudyMC.root.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/ProjectionCache.h"
+#include "plotting/UniverseArray.h"
+#include "plotting/KeyIndex.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TCanvas.h"
+#include "TColor.h"
+#include "TStyle.h"
+#include "TROOT.h"
+
+//c++ includes
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <algorithm>
+
+namespace
+{
+  const auto defaultOneDFileName = "MuonPT_manyCandsMC.root";
+  const auto defaultTwoDFileName = "MuonEfficiencyStudyMC.root";
+
+  const int colors[] = {kBlack, kBlue, kRed, kGreen+2, kMagenta};
+
+  //Each variable has a numerator for each process called <variable>_Numerator_<process>
+  const std::string MECName = "2p2h";
+  const std::vector<std::string> bkgNames = {"RES", "QE", "DIS", "Other"};
+
+  //nullptr if there's no MnvH2D called name
+  std::unique_ptr<PlotUtils::MnvH2D> readMnvH2D(TFile& file, const std::string& name)
+  {
+    std::unique_ptr<TObject> obj(file.Get(name.c_str()));
+    auto hist = dynamic_cast<PlotUtils::MnvH2D*>(obj.get());
+    if(hist) obj.release();
+    return std::unique_ptr<PlotUtils::MnvH2D>(hist);
+  }
+
+  //Draws a copy of proj's CV that belongs to the current pad
+  void drawProjection(const plot::ProjectionCache::Projection& proj, const std::string& title, const int color, const std::string& option)
+  {
+    TH1D hist(proj.cv);
+    hist.SetTitle(title.c_str());
+    hist.SetLineColor(color);
+    hist.DrawCopy(option.c_str());
+  }
+
+  //Returns 0 on success
+  int plotVariable(TFile& file, const plot::KeyIndex& index, const std::string& variable)
+  {
+    plot::ProjectionCache cache;
+
+    auto MECHist = ::readMnvH2D(file, variable + "_Numerator_" + MECName);
+    if(!MECHist) return 1;
+    cache.unpack(*MECHist);
+
+    std::vector<std::unique_ptr<PlotUtils::MnvH2D>> bkgs;
+    std::vector<std::string> bkgTitles;
+    for(const auto& bkgName: bkgNames)
+    {
+      const std::string name = variable + "_Numerator_" + bkgName;
+      if(!index.find(name))
+      {
+        std::cout << "No " << bkgName << " process for " << variable << ", so it's left out of the process breakdown.\n";
+        continue;
+      }
+
+      bkgs.push_back(::readMnvH2D(file, name));
+      if(!bkgs.back()) return 2;
+      bkgTitles.push_back(bkgName);
+    }
+
+    TCanvas canvas("plotEfficiencyAndProcesses");
+
+    //Process breakdown by individual components
+    int whichColor = 0;
+    ::drawProjection(cache.project(*MECHist, 'y'), MECName, colors[whichColor++], "HIST");
+    for(size_t whichBkg = 0; whichBkg < bkgs.size(); ++whichBkg)
+    {
+      ::drawProjection(cache.project(*bkgs[whichBkg], 'y'), bkgTitles[whichBkg], colors[whichColor++], "HIST SAME");
+    }
+    canvas.BuildLegend(0.7, 0.6, 0.95, 0.9);
+    canvas.Print((variable + "_processBreakdown.png").c_str());
+
+    //Process breakdown with all backgrounds together.  MECHist's projection is already cached.
+    if(!bkgs.empty())
+    {
+      std::vector<PlotUtils::MnvH2D*> toSum;
+      for(const auto& bkg: bkgs) toSum.push_back(bkg.get());
+      const std::string othersName = variable + "_Numerator_AllOthers";
+      cache.insert(othersName, plot::sum(toSum), *MECHist);
+
+      canvas.Clear();
+      ::drawProjection(cache.project(*MECHist, 'y'), MECName, kBlack, "HIST");
+      ::drawProjection(cache.project(othersName, 'y'), "All Others Stacked", kRed, "HIST SAME");
+      canvas.BuildLegend(0.55, 0.6, 0.95, 0.9);
+      canvas.Print((variable + "_processBreakdownStacked.png").c_str());
+    }
+
+    //2D efficiency with every process in the numerator
+    const std::string denName = variable + "_Denominator";
+    if(!index.find(denName))
+    {
+      std::cout << "Failed to find " << denName << ", so there's no efficiency for " << variable << ".\n";
+      return 0;
+    }
+
+    auto denominator = ::readMnvH2D(file, denName);
+    if(!denominator) return 3;
+    cache.unpack(*denominator);
+
+    plot::UniverseArray numerator = cache.unpack(*MECHist);
+    for(const auto& bkg: bkgs) numerator += cache.unpack(*bkg);
+    const std::string numName = variable + "_Numerator";
+    cache.insert(numName, numerator, *MECHist);
+
+    std::unique_ptr<PlotUtils::MnvH2D> efficiency(cache.efficiency(numName, denName).toMnvH2D(*denominator));
+    efficiency->SetTitle("Efficiency");
+    canvas.Clear();
+    efficiency->Draw("COLZ");
+    canvas.Print((variable + "_efficiency2D.png").c_str());
+
+    //Efficiency in each variable on its own
+    for(const char axis: {'x', 'y'})
+    {
+      canvas.Clear();
+      ::drawProjection(cache.efficiency(numName, denName, axis), "Efficiency", kBlack, "HIST");
+      canvas.Print((variable + "_efficiency_" + axis + ".png").c_str());
+    }
+
+    return 0;
+  }
+}
+
+int plotEfficiencyAndProcesses(const std::string& oneDFileName = defaultOneDFileName, const std::string& twoDFileName = defaultTwoDFileName)
+{
+  gStyle->SetHistLineWidth(3);
+  gStyle->SetOptStat(0);
+  gROOT->ForceStyle(); //Histograms I'm drawing were created with a different style,
+                       //so I need to tell them to override that style with this one.
+
+  std::unique_ptr<TFile> oneDFile(TFile::Open(oneDFileName.c_str()));
+  if(!oneDFile)
+  {
+    std::cerr << "Failed to open " << oneDFileName << " in plotEfficiency.\n";
+    return 1;
+  }
+
+  //1D efficiency
+  std::unique_ptr<PlotUtils::MnvH1D> oneDNum(dynamic_cast<PlotUtils::MnvH1D*>(oneDFile->Get("Tracker_MuonPTSignal_EfficiencyNumerator"))),
+                                     oneDDen(dynamic_cast<PlotUtils::MnvH1D*>(oneDFile->Get("Tracker_MuonPTSignal_EfficiencyDenominator")));
+  if(!oneDNum || !oneDDen)
+  {
+    std::cerr << "Failed to find the 1D efficiency numerator and denominator in " << oneDFileName << ".\n";
+    return 3;
+  }
+
+  plot::UniverseArray oneDEff(*oneDNum);
+  oneDEff /= plot::UniverseArray(*oneDDen);
+  oneDEff.fill(*oneDNum);
+
+  TCanvas canvas("efficiency");
+  oneDNum->Draw("HIST");
+  canvas.Print("efficiency.png");
+
+  std::unique_ptr<TFile> twoDFile(TFile::Open(twoDFileName.c_str()));
+  if(!twoDFile)
+  {
+    std::cerr << "Failed to open " << twoDFileName << " in plotEfficiency.\n";
+    return 2;
+  }
+
+  //Every variable with a 2p2h numerator
+  const plot::KeyIndex index(*twoDFile);
+  const std::regex MECNumerator("(.*)_Numerator_" + MECName);
+  auto keys = index.match(MECNumerator, "PlotUtils::MnvH2D");
+  if(keys.empty())
+  {
+    std::cerr << "Failed to find any MnvH2D called <variable>_Numerator_" << MECName << " in " << twoDFileName << ".\n";
+    return 4;
+  }
+
+  std::sort(keys.begin(), keys.end(), [](const auto& lhs, const auto& rhs) { return lhs.seek < rhs.seek; });
+
+  int nFailed = 0;
+  for(const auto& key: keys)
+  {
+    std::smatch found;
+    std::regex_match(key.name, found, MECNumerator);
+    if(::plotVariable(*twoDFile, index, found[1]) != 0)
+    {
+      std::cerr << "Failed to read every histogram for " << found[1] << ".\n";
+      ++nFailed;
+    }
+  }
+
+  return (nFailed > 0)?7:0;
+}
+
+#ifdef BUILD_STANDALONE
+int main(const int argc, const char** argv)
+{
+  if(argc != 1 && argc != 3)
+  {
+    std::cerr << "USAGE: " << argv[0] << " [oneDFile.root twoDFile.root]\n";
+    return 5;
+  }
+
+  gROOT->SetBatch(true);
+
+  try
+  {
+    if(argc == 3) return plotEfficiencyAndProcesses(argv[1], argv[2]);
+    return plotEfficiencyAndProcesses();
+  }
+  catch(const std::runtime_error& e)
+  {
+    std::cerr << e.what() << "\n";
+    return 6;
+  }
+}
+#endif //BUILD_STANDALONE
@@ -0,0 +1,50 @@
+//File: plotSideband.cpp
+//Brief: Draws data and MC histograms on the same canvas with a ratio of Data/MC
+//       on a canvas below for a sideband.  plotAllSidebands draws this for every sideband at once.
+//Usage: plotSideband data.root mc.root
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//plotting includes
+#include "plotting/Helpers.h"
+#include "plotting/SidebandPlots.h"
+
+//c++ includes
+#include <iostream>
+#include <string>
+
+int plotSideband(const std::string& dataFileName, const std::string& mcFileName)
+{
+  auto dataFile = plot::giveMeFileOrGiveMeDeath(dataFileName),
+       mcFile   = plot::giveMeFileOrGiveMeDeath(mcFileName);
+
+  plot::Sample data(*dataFile), mc(*mcFile);
+
+  const std::string fiducialName = "Tracker", sidebandName = "EAvailable";
+  return plot::sidebandRatio(data, mc, fiducialName, sidebandName, fiducialName + sidebandName + "DataMCRatio.png"); //TODO: Include file name here
+}
+
+#ifdef BUILD_STANDALONE
+//ROOT includes
+#include "TROOT.h"
+
+int main(const int argc, const char** argv)
+{
+  if(argc != 3)
+  {
+    std::cerr << "USAGE: " << argv[0] << " data.root mc.root\n";
+    return 2;
+  }
+
+  gROOT->SetBatch(true);
+
+  try
+  {
+    return plotSideband(argv[1], argv[2]);
+  }
+  catch(const std::runtime_error& e)
+  {
+    std::cerr << e.what() << "\n";
+    return 3;
+  }
+}
+#endif //BUILD_STANDALONE
@@ -0,0 +1,295 @@
+//File: plotUncertaintySummary.cpp
+//Brief: A ROOT script to plot an uncertainty summary for a number of neutrons distribution.
+//       Canvases are printed in parallel by a RenderPool with PLOT_RENDER_JOBS processes.
+//       The errors are saved in an ErrorSummary next to file.root, so drawing them again only reads CVs.
+//       The first time, backgrounds are read and summed on nThreads threads.  Defaults to one thread per core.
+//Usage: plotUncertaintySummary file.root [nThreads]
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//c++ includes
+#include <iostream>
+#include <algorithm>
+#include <memory>
+#include <map>
+#include <regex>
+#include <thread>
+#include <atomic>
+
+//plotting includes
+#include "plotting/RenderPool.h"
+#include "plotting/ErrorSummary.h"
+#include "plotting/KeyIndex.h"
+#include "plotting/CVFile.h"
+#include "plotting/Helpers.h"
+#include "plotting/UniverseArray.h"
+
+//ROOT includes
+#include "TROOT.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TCanvas.h"
+#include "THStack.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvPlotter.h"
+
+namespace
+{
+  const plot::ErrorSummary::Groups errorGroups = {{"CCQE Model", {"genie_CCQEPauliSupViaKF", "genie_NormCCQE", "genie_VecFFCCQEshape", "genie_MaCCQEshape"}},
+                                                                 {"Nucleon FSI", {"genie_FrAbs_N", "genie_FrCEx_N", "genie_FrElas_N", "genie_FrInel_N", "genie_MFP_N"}},
+                                                                 {"Pion FSI", {"genie_FrAbs_pi", "genie_FrCEx_pi", "genie_FrElas_pi", "genie_FrPiProd_pi", "genie_MFP_pi"}},
+                                                                 {"genie_NormCCRES", {"genie_NormCCRES"}},
+                                                                 {"Flux", {"Flux"}},
+                                                                 {"RPA_LowQ2", {"RPA_LowQ2"}},
+                                                                 {"2p2h", {"2p2h"}}};
+  constexpr auto signalName = "Neutron_Multiplicity_SelectedMCEvents";
+  constexpr auto bkgBaseName = "Neutron_Multiplicity_Background_";
+
+  std::string replaceAll(std::string source, const char toReplace, const std::string& with)
+  {
+    for(size_t found = source.find(toReplace); found != std::string::npos; found = source.find(toReplace))
+    {
+      source.replace(found, 1, with);
+    }
+
+    return source;
+  }
+
+  //Stacks the CVs of signal and each background.  Only MnvH1Ds whose CVs aren't in cvs yet are read.  Returns
+  //their sum, or nullptr if any of them is missing, in which case breakdown is left alone.
+  TH1D* stackCVs(plot::CVFile& cvs, const std::vector<plot::KeyInfo>& bkgKeys, THStack& breakdown)
+  {
+    std::vector<std::string> names{::signalName};
+    for(const auto& key: bkgKeys) names.push_back(key.name);
+
+    const auto components = cvs.get(names);
+    if(std::any_of(components.begin(), components.end(), [](const TH1D* component) { return component == nullptr; }))
+    {
+      for(auto component: components) delete component;
+      return nullptr;
+    }
+
+    auto total = static_cast<TH1D*>(components.front()->Clone());
+    for(auto component: components)
+    {
+      if(component != components.front()) total->Add(component);
+      breakdown.Add(component);
+    }
+    breakdown.SetHistogram(static_cast<TH1D*>(components.front()->Clone()));
+
+    return total;
+  }
+
+  //Reads backgrounds on nThreads threads.  TFiles can't be shared between threads, so each thread opens fileName
+  //again.  Each thread sums every nThreads-th background into its own UniverseArray, and those are added to signal
+  //in thread order so that the total doesn't depend on which thread finishes first.  bkgCVs gets each background's
+  //CV with errors in the same order as bkgKeys.  Returns how many backgrounds couldn't be read or added.
+  int addBackgrounds(const std::string& fileName, const std::vector<plot::KeyInfo>& bkgKeys, const int nThreads,
+                     plot::UniverseArray& signal, std::vector<TH1D*>& bkgCVs)
+  {
+    ROOT::EnableThreadSafety();
+    const bool addDirectory = TH1::AddDirectoryStatus();
+    TH1::AddDirectory(false); //Or every thread's histograms go in the same list
+
+    const size_t stride = std::max(1, std::min<int>(nThreads, bkgKeys.size()));
+    std::vector<std::unique_ptr<plot::UniverseArray>> partials(stride);
+    bkgCVs.assign(bkgKeys.size(), nullptr);
+    std::atomic<int> nFailed(0);
+
+    auto worker = [&](const size_t whichThread)
+    {
+      std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+      std::unique_ptr<plot::UniverseArray> next; //Reused for every background after the first
+
+      for(size_t whichBkg = whichThread; whichBkg < bkgKeys.size(); whichBkg += stride)
+      {
+        std::unique_ptr<PlotUtils::MnvH1D> component(file?plot::readMnvH1D(*file, bkgKeys[whichBkg].name):nullptr);
+        if(!component)
+        {
+          std::cerr << "Failed to read " << bkgKeys[whichBkg].name << " from " << fileName << ".\n";
+          ++nFailed;
+          continue;
+        }
+        component->SetDirectory(nullptr);
+
+        bkgCVs[whichBkg] = static_cast<TH1D*>(component->GetCVHistoWithError().Clone());
+        try
+        {
+          auto& partial = partials[whichThread];
+          if(!partial) partial.reset(new plot::UniverseArray(*component));
+          else
+          {
+            if(next) next->read(*component);
+            else next.reset(new plot::UniverseArray(*component));
+            *partial += *next;
+          }
+        }
+        catch(const std::runtime_error& e)
+        {
+          std::cerr << "Failed to add " << bkgKeys[whichBkg].name << ": " << e.what() << "\n";
+          ++nFailed;
+        }
+      }
+    };
+
+    std::vector<std::thread> pool;
+    for(size_t whichThread = 0; whichThread < stride; ++whichThread) pool.emplace_back(worker, whichThread);
+    for(auto& thread: pool) thread.join();
+
+    TH1::AddDirectory(addDirectory);
+
+    for(const auto& partial: partials)
+    {
+      if(!partial) continue;
+      try
+      {
+        signal += *partial;
+      }
+      catch(const std::runtime_error& e)
+      {
+        std::cerr << "Failed to add backgrounds to " << ::signalName << ": " << e.what() << "\n";
+        ++nFailed;
+      }
+    }
+
+    return nFailed;
+  }
+}
+
+int plotUncertaintySummary(const std::string fileName, const int nThreads)
+{
+  //Open the input file
+  std::unique_ptr<TFile> inFile(TFile::Open(fileName.c_str(), "READ"));
+  if(!inFile)
+  {
+    std::cerr << "Failed to open a ROOT file named " << fileName << ".\n";
+    return 1;
+  }
+
+  const std::string baseName = fileName.substr(0, fileName.find(".root"));
+
+  //Check that every background is an MnvH1D before reading anything
+  const plot::KeyIndex index(*inFile);
+  const std::regex bkgPattern(".*" + std::string(::bkgBaseName) + ".*");
+  const auto bkgKeys = index.match(bkgPattern);
+  for(const auto& key: index.match(bkgPattern, "TObject"))
+  {
+    if(std::none_of(bkgKeys.begin(), bkgKeys.end(), [&key](const plot::KeyInfo& bkg) { return bkg.name == key.name; }))
+    {
+      std::cerr << "An object named " << key.name << " in " << fileName << " appeared to be related to the background name pattern "
+                << bkgBaseName << ", but it's not an MnvH1D!  Throw these results out.\n";
+      return 3;
+    }
+  }
+
+  const std::string version = plot::KeyIndex::version(*inFile),
+                    sidecar = plot::ErrorSummary::sidecarName(fileName, ::signalName);
+  plot::ErrorSummary errors(sidecar, version, ::errorGroups);
+
+  THStack breakdown;
+  std::unique_ptr<TH1D> total;
+
+  //The errors were already calculated.  Everything else only needs CVs.  The run that calculated the errors
+  //saved them in cvs, so nothing but the keys is read from inFile unless that failed.
+  plot::CVFile cvs(*inFile, index);
+  if(errors.isValid())
+  {
+    total.reset(::stackCVs(cvs, bkgKeys, breakdown));
+    if(total && static_cast<int>(errors.total().size()) != total->GetNcells()) //Can't be for these bins
+    {
+      total.reset();
+      breakdown.GetHists()->Delete();
+    }
+    if(total)
+    {
+      for(int whichCell = 0; whichCell < total->GetNcells(); ++whichCell) total->SetBinError(whichCell, errors.total()[whichCell]*total->GetBinContent(whichCell));
+    }
+  }
+
+  if(!total)
+  {
+    //Find the histogram of selected signal events
+    auto signal = static_cast<PlotUtils::MnvH1D*>(inFile->Get(::signalName));
+    if(!signal)
+    {
+      std::cerr << "Failed to find an MnvH1D called " << signalName << " in a file named " << fileName << ".\n";
+      return 2;
+    }
+
+    auto signalCV = static_cast<TH1D*>(signal->GetCVHistoWithError().Clone());
+    breakdown.Add(signalCV);
+    breakdown.SetHistogram(static_cast<TH1D*>(signal->GetCVHistoWithError().Clone()));
+
+    //Add all selected background events to signal
+    plot::UniverseArray summed(*signal);
+    std::vector<TH1D*> bkgCVs;
+    if(::addBackgrounds(fileName, bkgKeys, nThreads, summed, bkgCVs) > 0)
+    {
+      std::cerr << "Failed to add every background in " << fileName << " to " << signalName << ".  Throw these results out.\n";
+      return 3;
+    }
+    for(auto cv: bkgCVs) breakdown.Add(cv);
+
+    //So that drawing these plots again doesn't have to read any of these MnvH1Ds
+    std::vector<std::pair<std::string, const TH1D*>> cvsRead{{::signalName, signalCV}};
+    for(size_t whichBkg = 0; whichBkg < bkgKeys.size(); ++whichBkg) cvsRead.emplace_back(bkgKeys[whichBkg].name, bkgCVs[whichBkg]);
+    cvs.add(cvsRead);
+
+    //Every band and group in one pass over the universes
+    errors = plot::ErrorSummary(summed, ::errorGroups);
+    errors.write(sidecar, version);
+    std::unique_ptr<PlotUtils::MnvH1D> summedHist(summed.toMnvH1D(*signal));
+    total.reset(static_cast<TH1D*>(summedHist->GetCVHistoWithError().Clone()));
+  }
+
+  //Set up a MnvPlotter.  Its constructor sets up MINERvA's plot style.
+  TCanvas output(baseName.c_str(), "No Title");
+  plot::RenderPool pool;
+  PlotUtils::MnvPlotter plotter;
+
+  //Plot the error band summary itself
+  output.SetTitle("Error Band Summary");
+  errors.draw(output, *total);
+  pool.print(output, baseName + "_errors.png");
+
+  //Plot the total signal with error bars
+  output.SetTitle("Total Signal");
+  total->Draw();
+  pool.print(output, baseName + "_totalSignal.png");
+
+  //Plot a stack of selected events with error bars
+  output.SetTitle("Background Breakdown");
+  breakdown.Draw("HIST PFC PLC");
+  output.BuildLegend(0.6, 0.65, 0.9, 0.95);
+  pool.print(output, baseName + "_breakdown.png");
+
+  //Plot each error band category
+  for(const auto& cat: errors.groups())
+  {
+    output.SetTitle(cat.first.c_str());
+    errors.drawGroup(output, *total, cat.first);
+    pool.print(output, baseName + "_" + ::replaceAll(cat.first, ' ', "_") + ".png");
+  }
+
+  const auto failed = pool.wait();
+  for(const auto& fileName: failed) std::cerr << "Failed to print " << fileName << ".\n";
+
+  return failed.empty()?0:4;
+}
+
+#ifdef BUILD_STANDALONE
+int main(const int argc, const char** argv)
+{
+  if(argc < 2 || argc > 3)
+  {
+    std::cerr << "USAGE: " << argv[0] << " file.root [nThreads]\n";
+    return 5;
+  }
+
+  gROOT->SetBatch(true);
+
+  const int nThreads = (argc > 2)?std::stoi(argv[2]):std::max(1u, std::thread::hardware_concurrency());
+  return plotUncertaintySummary(argv[1], nThreads);
+}
+#endif //BUILD_STANDALONE
@@ -0,0 +1,197 @@
+//File: smearingFractionStudy.cpp
+//Brief: Given a migration matrix in a variable I want to cut on, graph the fraction of events that pass both
+//       the reconstructed and the truth cut for different cut values.   This helps me decide whether a cut
+//       will need background subtraction or will be sufficient as a phase space cut.  Values less than 90%
+//       or so probably need background subtraction.  Also maps that fraction for every pair of a truth cut
+//       and a reco cut in case they shouldn't be the same.  MnvH2Ds get error bars from their universes.
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+//Usage: smearingFractionStudy nameOfFile.root nameOfMigrationMatrix
+//       nameOfMigrationMatrix is a regular expression, so one run can study every matching matrix in a file.
+//N.B.: X axis is asummed to be TRUTH unless only the Y axis label has "True" in it
+
+//plotting includes
+#include "plotting/CutScan.h"
+#include "plotting/KeyIndex.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TKey.h"
+#include "TH2.h"
+#include "TGraphErrors.h"
+#include "TCanvas.h"
+
+//c++ includes
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <algorithm>
+
+namespace
+{
+  //Figure out which axis has truth quantities to make it harder to mess up this study
+  bool findXIsTrue(const TH2& hist)
+  {
+    bool xIsTrue = true; //Default assumption in case I can't detect truth
+    std::string origXLabel = hist.GetXaxis()->GetTitle(),
+                origYLabel = hist.GetYaxis()->GetTitle();
+    if((origXLabel.find("True") == std::string::npos))
+    {
+      if(origYLabel.find("True") != std::string::npos) xIsTrue = false;
+      else std::cout << "Failed to find \"True\" in either axis label of " << hist.GetName() << ".  "
+                     << "Assuming that the x axis has a truth quantity and the Y axis has a reco quantity.\n";
+    }
+
+    return xIsTrue;
+  }
+
+  //Works for variable-width bins too
+  std::vector<double> edgesOf(const TAxis& axis)
+  {
+    std::vector<double> edges;
+    for(int whichBin = 1; whichBin <= axis.GetNbins() + 1; ++whichBin) edges.push_back(axis.GetBinLowEdge(whichBin));
+    return edges;
+  }
+
+  //Returns 0 on success
+  int study(const TH2& hist, const std::string& histName)
+  {
+    const bool xIsTrue = ::findXIsTrue(hist);
+    const auto mnvHist = dynamic_cast<const PlotUtils::MnvH2D*>(&hist);
+    const plot::CutScan scan = mnvHist?plot::CutScan(*mnvHist, xIsTrue):plot::CutScan(hist, xIsTrue);
+    const int allTruth = scan.nTruthBins() + 1; //Passes any truth cut
+
+    auto truthAxis = xIsTrue?hist.GetXaxis():hist.GetYaxis(),
+         recoAxis = xIsTrue?hist.GetYaxis():hist.GetXaxis();
+
+    std::string newAxisLabel = truthAxis->GetTitle();
+    const size_t foundTrue = newAxisLabel.find("True");
+    if(foundTrue != std::string::npos) newAxisLabel.erase(foundTrue, foundTrue + 5);
+    newAxisLabel += " Cut";
+
+    TCanvas canvas("smearingFractionStudy");
+
+    //The same cut on both axes
+    if(scan.nTruthBins() == scan.nRecoBins())
+    {
+      const int nBins = scan.nTruthBins();
+
+      //Set up the graph I'm going to draw
+      TGraphErrors graph(nBins);
+      graph.SetTitle("Smearing Fraction Study");
+
+      graph.GetXaxis()->SetTitle(newAxisLabel.c_str());
+      graph.GetYaxis()->SetTitle("% of Reco Events that Pass Reco and True Cuts");
+
+      //Keep track of axis limits to zoom in on region of interest
+      double minY = 100, maxY = 0;
+
+      for(int whichBin = 0; whichBin < nBins; ++whichBin)
+      {
+        if(scan.passed(allTruth, whichBin) > 0)
+        {
+          //Now, graph the percentage of reco events that passed both cuts.
+          const double percentPassed = scan.passBoth(whichBin, whichBin)*100.;
+          minY = std::min(percentPassed, minY);
+          maxY = std::max(percentPassed, maxY);
+          graph.SetPoint(whichBin, truthAxis->GetBinUpEdge(whichBin), percentPassed);
+          graph.SetPointError(whichBin, 0, scan.passBothError(whichBin, whichBin)*100.);
+        }
+      }
+
+      graph.SetMinimum(minY - 5);
+      graph.SetMaximum(std::min(maxY + 5, 100.));
+      graph.SetMarkerStyle(kFullCircle);
+      graph.Draw("AP");
+      canvas.Print((histName + "_smearingFractionStudy.png").c_str());
+    }
+    else std::cout << histName << " has different numbers of truth and reco bins, so it only gets a map of every pair of cuts.\n";
+
+    //Every pair of cuts.  Each bin is for cuts at its upper edges.
+    const auto truthEdges = ::edgesOf(*truthAxis), recoEdges = ::edgesOf(*recoAxis);
+    const std::string titles = std::string("% of Reco Events that Pass Reco and True Cuts;") + newAxisLabel + ";" + recoAxis->GetTitle() + " Cut";
+    TH2D map((histName + "_cutScan").c_str(), titles.c_str(), scan.nTruthBins(), truthEdges.data(), scan.nRecoBins(), recoEdges.data());
+    map.SetDirectory(nullptr);
+
+    for(int whichTruth = 1; whichTruth <= scan.nTruthBins(); ++whichTruth)
+    {
+      for(int whichReco = 1; whichReco <= scan.nRecoBins(); ++whichReco)
+      {
+        if(scan.passed(allTruth, whichReco) > 0) map.SetBinContent(whichTruth, whichReco, scan.passBoth(whichTruth, whichReco)*100.);
+      }
+    }
+
+    map.SetMinimum(0);
+    map.SetMaximum(100);
+    map.Draw("COLZ");
+    canvas.Print((histName + "_cutScan.png").c_str());
+
+    return 0;
+  }
+}
+
+int smearingFractionStudy(const std::string& fileName, const std::string& histName)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str()));
+  if(!file)
+  {
+    std::cerr << "Failed to open " << fileName << ".  Bailing...\n";
+    return 1;
+  }
+
+  const plot::KeyIndex index(*file);
+  auto keys = index.match(std::regex(histName), "TH2");
+  if(keys.empty())
+  {
+    if(index.find(histName))
+    {
+      std::cerr << "Found a TObject named " << histName << " in " << fileName << ", but it's not a TH2.  "
+                << "So I can't project it.  Bailing...\n";
+      return 3;
+    }
+
+    std::cerr << "Failed to find a TH2 named " << histName << " in " << fileName << ".  Bailing...\n";
+    return 2;
+  }
+
+  //Read the matrices in the order they're in the file
+  std::sort(keys.begin(), keys.end(), [](const auto& lhs, const auto& rhs) { return lhs.seek < rhs.seek; });
+
+  int nFailed = 0;
+  for(const auto& key: keys)
+  {
+    std::unique_ptr<TObject> obj(file->GetKey(key.name.c_str())->ReadObj());
+    auto hist = dynamic_cast<TH2*>(obj.get());
+    if(!hist || ::study(*hist, key.name) != 0) ++nFailed;
+  }
+
+  return (nFailed > 0)?4:0;
+}
+
+#ifdef BUILD_STANDALONE
+//ROOT includes
+#include "TROOT.h"
+
+int main(const int argc, const char** argv)
+{
+  if(argc != 3)
+  {
+    std::cerr << "USAGE: " << argv[0] << " nameOfFile.root nameOfMigrationMatrix\n";
+    return 5;
+  }
+
+  gROOT->SetBatch(true);
+
+  try
+  {
+    return smearingFractionStudy(argv[1], argv[2]);
+  }
+  catch(const std::runtime_error& e)
+  {
+    std::cerr << e.what() << "\n";
+    return 6;
+  }
+}
+#endif //BUILD_STANDALONE
@@ -0,0 +1,78 @@
+//File: slimHists.cpp
+//Brief: Copies a few MnvH1Ds and MnvH2Ds to a new file with only their CVs and statistical errors.
+//       runWarping.make uses this to give every TransWarpExtraction job a migration file that's a few kB
+//       instead of making each one deserialize every universe of a big MnvH2D migration matrix that it
+//       never uses.  POTUsed comes along too.
+//Usage: root -l -b -q slimHists.cpp+("merged/study_cvMC.root", "merged/study_cvMigration.root", "Tracker_Neutron_Multiplicity_Migration,Tracker_Neutron_Multiplicity_SelectedMCEvents")
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TFile.h"
+
+//c++ includes
+#include <iostream>
+#include <sstream>
+#include <memory>
+
+namespace
+{
+  std::vector<std::string> split(const std::string& list, const char delim)
+  {
+    std::vector<std::string> words;
+    std::stringstream stream(list);
+    std::string word;
+    while(std::getline(stream, word, delim)) words.push_back(word);
+    return words;
+  }
+}
+
+int slimHists(const std::string& inFileName, const std::string& outFileName, const std::string& histNames)
+{
+  TH1::AddDirectory(false); //I'll decide which file each histogram goes to
+
+  std::unique_ptr<TFile> inFile(TFile::Open(inFileName.c_str(), "READ"));
+  if(!inFile)
+  {
+    std::cerr << "Failed to open a file named " << inFileName << ".\n";
+    return 1;
+  }
+
+  std::unique_ptr<TFile> outFile(TFile::Open(outFileName.c_str(), "RECREATE"));
+  if(!outFile)
+  {
+    std::cerr << "Failed to create a file named " << outFileName << ".\n";
+    return 2;
+  }
+
+  for(const auto& name: ::split(histNames, ','))
+  {
+    auto obj = inFile->Get(name.c_str());
+    if(auto twoD = dynamic_cast<PlotUtils::MnvH2D*>(obj))
+    {
+      PlotUtils::MnvH2D slim(twoD->GetCVHistoWithStatError());
+      slim.SetName(name.c_str());
+      outFile->WriteTObject(&slim, name.c_str());
+    }
+    else if(auto oneD = dynamic_cast<PlotUtils::MnvH1D*>(obj))
+    {
+      PlotUtils::MnvH1D slim(oneD->GetCVHistoWithStatError());
+      slim.SetName(name.c_str());
+      outFile->WriteTObject(&slim, name.c_str());
+    }
+    else
+    {
+      std::cerr << "Failed to find an MnvH1D or MnvH2D named " << name << " in " << inFileName << ".\n";
+      return 3;
+    }
+  }
+
+  auto pot = inFile->Get("POTUsed");
+  if(pot) outFile->WriteTObject(pot, "POTUsed");
+  else std::cerr << inFileName << " doesn't have POT information.  " << outFileName << " won't either.\n";
+
+  return 0;
+}
@@ -0,0 +1,215 @@
+#!/bin/bash
+#Copies tuple files from a slow disk like TUPLE_DIR to a cache on a local disk so that ProcessAnaTuples reads
+#them from there instead of every job seeking around the slow disk at once.  Each disk only has
+#TUPLE_STAGE_COPIES files copied from it at a time, so it streams a few files instead of seeking between
+#every job's reads, and tuples on different disks are copied in parallel.  The cache is shared by every job,
+#CV and warped configurations, and later studies.  When it would grow past TUPLE_STAGE_BYTES, the least
+#recently used files that no job is reading right now are deleted.  A file is copied again if its size or
+#modification time changes.  Until a file has been copied, its path in the cache is a symbolic link to the
+#original.  So a path from stage can always be read, and anything that opens it after the copy gets the copy.
+#  stage: copies the first file, prints the path to read each file from, and then copies the rest in the
+#         background in the order they'll be read.  So processing starts as soon as one file is local and the
+#         slow disk is read while the files before are processed.  The files stay in the cache until "release"
+#         with the same process ID, which also stops the background copies after the file they're on.
+#         Prints the original path for any file that can't even be linked to.
+#  prefetch: copies files that will be needed soon while something else is being processed.  Stops when the
+#            cache is full.
+#USAGE: stageTuples.sh stage processID tupleFiles...
+#       stageTuples.sh prefetch tupleFiles...
+#       stageTuples.sh release processID
+
+STAGE_DIR=${TUPLE_STAGE_DIR:-"/tmp/${USER}/tupleStage"}
+MAX_BYTES=${TUPLE_STAGE_BYTES:-200000000000}
+MAX_COPIES=${TUPLE_STAGE_COPIES:-2}
+
+if [ $# -lt 2 ]
+then
+  echo "USAGE: $0 stage processID tupleFiles..." >&2
+  echo "       $0 prefetch tupleFiles..." >&2
+  echo "       $0 release processID" >&2
+  exit 1
+fi
+
+MODE=$1
+shift
+
+mkdir -p ${STAGE_DIR}/files ${STAGE_DIR}/.pins ${STAGE_DIR}/.locks || exit 2
+
+localName()
+{
+  echo ${STAGE_DIR}/files$(readlink -f $1)
+}
+
+#Cached files that a running job is reading.  Forgets about jobs that died without releasing their files.
+pinned()
+{
+  local PIN
+  for PIN in ${STAGE_DIR}/.pins/*
+  do
+    [ -e ${PIN} ] || continue
+    if kill -0 $(basename ${PIN}) 2>/dev/null
+    then
+      cat ${PIN}
+    else
+      rm -f ${PIN}
+    fi
+  done
+}
+
+#Delete the least recently used files that no job is reading until there's room for $1 more bytes.
+#Copies in progress already take up their whole size.  Only call this while holding the bookkeeping lock.
+makeRoom()
+{
+  local NEEDED=$1
+  local USED=$(find ${STAGE_DIR}/files -type f -printf '%s\n' | awk '{ sum += $1 } END { printf "%.0f", sum }')
+  [ $((USED + NEEDED)) -le ${MAX_BYTES} ] && return 0
+
+  local PINNED=$(pinned)
+  local ACCESSED SIZE FILE
+  while read ACCESSED SIZE FILE
+  do
+    [[ "$(basename ${FILE})" == .partial_* ]] && continue
+    echo "${PINNED}" | grep -qxF ${FILE} && continue
+
+    rm -f ${FILE}
+    USED=$((USED - SIZE))
+    [ $((USED + NEEDED)) -le ${MAX_BYTES} ] && return 0
+  done < <(find ${STAGE_DIR}/files -type f -printf '%A@ %s %p\n' | sort -n)
+
+  return 1
+}
+
+#True if $1 is a copy in the cache of a file whose size and modification time are $2
+isCached()
+{
+  [ ! -L $1 ] && [ "$(stat -c '%s %Y' $1 2>/dev/null)" == "$2" ]
+}
+
+#Make $2, the path of $1 in the cache, a link to $1.  The link replaces an outdated copy in one rename so
+#that there's never a moment when $2 can't be read.
+pointAtSource()
+{
+  local LINK=$(dirname $2)/.link_$(basename $2).${BASHPID}
+  mkdir -p $(dirname $2) && ln -sfn $1 ${LINK} && mv -Tf ${LINK} $2
+}
+
+#Wait for one of the MAX_COPIES copy slots for the disk that $1 is on.  The slot is held on file descriptor 6.
+takeCopySlot()
+{
+  local DEVICE=$(stat -c '%d' $1)
+  local SLOT
+  while true
+  do
+    for SLOT in $(seq 1 ${MAX_COPIES})
+    do
+      exec 6> ${STAGE_DIR}/.locks/copying_${DEVICE}_${SLOT}
+      flock -n 6 && return 0
+      exec 6>&-
+    done
+    sleep 1
+  done
+}
+
+#Make sure there's an up to date copy of $1 in the cache.  Fails if it doesn't fit.
+stageOne()
+{
+  local SOURCE=$(readlink -f $1)
+  local LOCAL=$(localName ${SOURCE})
+  local PARTIAL=$(dirname ${LOCAL})/.partial_$(basename ${LOCAL})
+  local VERSION
+  VERSION=$(stat -c '%s %Y' ${SOURCE}) || return 1
+  local SIZE=${VERSION% *}
+
+  #Only one job copies each file.  Others wait for it and then find it cached.
+  exec 8> ${STAGE_DIR}/.locks/$(echo ${SOURCE} | sha256sum | cut -d ' ' -f 1)
+  flock 8
+
+  if isCached ${LOCAL} "${VERSION}"
+  then
+    touch -a ${LOCAL}
+    exec 8>&-
+    return 0
+  fi
+  pointAtSource ${SOURCE} ${LOCAL}
+
+  #Reserve the space for this file before copying so that other jobs count it too
+  exec 7> ${STAGE_DIR}/.lock
+  flock 7
+  if ! makeRoom ${SIZE} || ! truncate -s ${SIZE} ${PARTIAL}
+  then
+    exec 7>&- 8>&-
+    return 1
+  fi
+  exec 7>&-
+
+  local STATUS=0
+  takeCopySlot ${SOURCE}
+  if cp --preserve=timestamps ${SOURCE} ${PARTIAL}
+  then
+    mv -f ${PARTIAL} ${LOCAL} && touch -a ${LOCAL} || STATUS=1
+  else
+    rm -f ${PARTIAL}
+    STATUS=1
+  fi
+
+  exec 6>&- 8>&-
+  return ${STATUS}
+}
+
+case ${MODE} in
+  stage)
+    PIN=${STAGE_DIR}/.pins/$1
+    shift
+    for FILE in "$@"
+    do
+      localName ${FILE}
+    done >> ${PIN}
+
+    #Every path has to be readable before ProcessAnaTuples starts.  A file whose lock is taken is being copied
+    #by another job, and that job links to the original first.
+    for FILE in "$@"
+    do
+      SOURCE=$(readlink -f ${FILE})
+      exec 8> ${STAGE_DIR}/.locks/$(echo ${SOURCE} | sha256sum | cut -d ' ' -f 1)
+      if flock -n 8 && ! isCached $(localName ${SOURCE}) "$(stat -c '%s %Y' ${SOURCE})"
+      then
+        pointAtSource ${SOURCE} $(localName ${SOURCE})
+      fi
+      exec 8>&-
+    done
+
+    stageOne $1 || echo "No room to stage $1 in ${STAGE_DIR}.  Reading it from where it is." >&2
+    for FILE in "$@"
+    do
+      if [ -e $(localName ${FILE}) ]
+      then
+        localName ${FILE}
+      else
+        echo ${FILE}
+      fi
+    done
+
+    #Copy the rest while the first files are processed.  Nothing reads this output, so the caller doesn't wait.
+    shift
+    (
+      for FILE in "$@"
+      do
+        [ -e ${PIN} ] || break
+        stageOne ${FILE} || break
+      done
+    ) > /dev/null 2>&1 < /dev/null &
+    ;;
+  prefetch)
+    for FILE in "$@"
+    do
+      stageOne ${FILE} || break
+    done
+    ;;
+  release)
+    rm -f ${STAGE_DIR}/.pins/$1
+    ;;
+  *)
+    echo "Unknown mode ${MODE}.  Use stage, prefetch, or release." >&2
+    exit 1
+    ;;
+esac
@@ -0,0 +1,105 @@
+#!/bin/bash
+#Run one step of a warping study and append how long it took and what it used to STAGE_LOG.
+#Records wall time, CPU time, peak RSS, bytes read and written, and how much from and to storage.
+#Linux adds a process's CPU time and I/O to whoever waits for it, so everything the command starts is
+#counted too.  Peak RSS needs GNU time in /usr/bin/time and is left empty without it.
+#--items counts whatever the step works through, like tuple files or universes, for a rate in the report.
+#A command that knows better can write "nItems unit" to the file named by STAGE_ITEMS_FILE to replace it.
+#cachedProcessAnaTuples.sh does that with the number of events it processed.
+#makeReport.sh turns STAGE_LOG into a report and a timeline.
+#Each line of STAGE_LOG is: run,stage,target,exitCode,startSeconds,wallSeconds,cpuSeconds,maxRSSkB,readBytes,writtenBytes,storageReadBytes,storageWrittenBytes,items,itemUnit
+#USAGE: timeStage.sh stageName target [--items nItems unit] command...
+#Returns the command's exit code.
+
+if [ $# -lt 3 ]
+then
+  echo "USAGE: $0 stageName target [--items nItems unit] command..." >&2
+  exit 1
+fi
+
+STAGE=$1
+TARGET=$2
+shift 2
+
+ITEMS=
+ITEM_UNIT=
+if [ "$1" == "--items" ]
+then
+  ITEMS=$2
+  ITEM_UNIT=$3
+  shift 3
+fi
+
+STAGE_LOG=${STAGE_LOG:-stages.txt}
+CLOCK_TICKS=$(getconf CLK_TCK)
+
+#Reads this shell's own /proc entries without starting another process that would get counted instead
+readUsage()
+{
+  local STAT
+  read -a STAT < /proc/$$/stat
+  CHILD_TICKS=$((STAT[15] + STAT[16])) #cutime and cstime: CPU time of every process this shell has waited for
+
+  local KEY VALUE
+  while read KEY VALUE
+  do
+    case ${KEY} in
+      rchar:) READ=${VALUE};;
+      wchar:) WRITTEN=${VALUE};;
+      read_bytes:) STORAGE_READ=${VALUE};;
+      write_bytes:) STORAGE_WRITTEN=${VALUE};;
+    esac
+  done < /proc/$$/io
+}
+
+now()
+{
+  echo ${EPOCHREALTIME:-$(date +%s.%N)}
+}
+
+export STAGE_ITEMS_FILE=$(mktemp)
+
+RSS_FILE=
+if [ -x /usr/bin/time ] && /usr/bin/time -f %M -o /dev/null true 2>/dev/null
+then
+  RSS_FILE=$(mktemp)
+fi
+
+readUsage
+START_TICKS=${CHILD_TICKS}
+START_READ=${READ}
+START_WRITTEN=${WRITTEN}
+START_STORAGE_READ=${STORAGE_READ}
+START_STORAGE_WRITTEN=${STORAGE_WRITTEN}
+START=$(now)
+
+if [ -n "${RSS_FILE}" ]
+then
+  /usr/bin/time -f %M -o ${RSS_FILE} "$@"
+else
+  "$@"
+fi
+STATUS=$?
+
+END=$(now)
+readUsage
+
+MAX_RSS=
+if [ -n "${RSS_FILE}" ]
+then
+  MAX_RSS=$(tail -n 1 ${RSS_FILE})
+  rm -f ${RSS_FILE}
+fi
+
+if [ -s ${STAGE_ITEMS_FILE} ]
+then
+  read ITEMS ITEM_UNIT < ${STAGE_ITEMS_FILE}
+fi
+rm -f ${STAGE_ITEMS_FILE}
+
+#One write per line so that steps finishing at the same time don't mix their lines
+mkdir -p $(dirname ${STAGE_LOG})
+LINE="${RUN_ID},${STAGE},${TARGET},${STATUS},${START},$(awk -v start=${START} -v end=${END} 'BEGIN {printf "%.3f", end - start}'),$(awk -v ticks=$((CHILD_TICKS - START_TICKS)) -v perSecond=${CLOCK_TICKS} 'BEGIN {printf "%.2f", ticks/perSecond}'),${MAX_RSS},$((READ - START_READ)),$((WRITTEN - START_WRITTEN)),$((STORAGE_READ - START_STORAGE_READ)),$((STORAGE_WRITTEN - START_STORAGE_WRITTEN)),${ITEMS},${ITEM_UNIT}"
+echo "${LINE}" >> ${STAGE_LOG}
+
+exit ${STATUS}
@@ -0,0 +1,107 @@
+//File: validateOutput.cpp
+//Brief: Checks that a ROOT file from one step of a warping study is complete before runWarping.make lets the
+//       next step read it.  A file is valid if ROOT can open it without recovering it, which it only has to
+//       do when whatever wrote the file crashed before closing it, and every object named has been written.
+//       Compiled with -DBUILD_STANDALONE (scripts/CMakeLists.txt does this), it becomes a validateOutput
+//       program that checks many files at once.  --delete removes the invalid files so that make remakes them.
+//Usage: root -l -b -q validateOutput.cpp+("merged/study_cvMC.root", "POTUsed")
+//       validateOutput [--delete] [-k object1,object2] files...
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+#include "TFile.h"
+
+#include <iostream>
+#include <sstream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  std::vector<std::string> split(const std::string& list, const char delim)
+  {
+    std::vector<std::string> words;
+    std::stringstream stream(list);
+    std::string word;
+    while(std::getline(stream, word, delim)) if(!word.empty()) words.push_back(word);
+    return words;
+  }
+}
+
+//objectNames is a comma-separated list.  Objects in a TDirectory look like dirName/objectName.
+//Returns 0 when fileName is valid.
+int validateOutput(const std::string& fileName, const std::string& objectNames)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+  if(!file || file->IsZombie())
+  {
+    std::cerr << fileName << " isn't a ROOT file that can be opened.\n";
+    return 1;
+  }
+
+  if(file->TestBit(TFile::kRecovered))
+  {
+    std::cerr << fileName << " was never closed.  Whatever wrote it probably crashed.\n";
+    return 2;
+  }
+
+  for(const auto& name: ::split(objectNames, ','))
+  {
+    if(!file->Get(name.c_str()))
+    {
+      std::cerr << fileName << " is missing " << name << ".\n";
+      return 3;
+    }
+  }
+
+  return 0;
+}
+
+#ifdef BUILD_STANDALONE
+//c++ includes
+#include <cstdio>
+
+int main(const int argc, const char** argv)
+{
+  const std::string usage = std::string("USAGE: ") + argv[0] + " [--delete] [-k object1,object2] files...\n";
+
+  bool deleteInvalid = false;
+  std::string objectNames;
+  std::vector<std::string> fileNames;
+
+  for(int whichArg = 1; whichArg < argc; ++whichArg)
+  {
+    const std::string arg = argv[whichArg];
+    if(arg == "-k" && whichArg + 1 >= argc)
+    {
+      std::cerr << arg << " needs a value.\n" << usage;
+      return 4;
+    }
+
+    if(arg == "-k") objectNames = argv[++whichArg];
+    else if(arg == "--delete") deleteInvalid = true;
+    else if(arg == "-h" || arg == "--help")
+    {
+      std::cout << usage;
+      return 0;
+    }
+    else fileNames.push_back(arg);
+  }
+
+  int nInvalid = 0;
+  for(const auto& fileName: fileNames)
+  {
+    if(validateOutput(fileName, objectNames) == 0) continue;
+
+    ++nInvalid;
+    if(deleteInvalid)
+    {
+      if(std::remove(fileName.c_str()) == 0) std::cerr << "Deleted " << fileName << " so that it will be made again.\n";
+      else std::cerr << "Failed to delete " << fileName << ".\n";
+    }
+  }
+
+  if(nInvalid > 0) std::cerr << nInvalid << " of " << fileNames.size() << " files are invalid.\n";
+
+  return (nInvalid > 0 && !deleteInvalid)?1:0;
+}
+#endif //BUILD_STANDALONE
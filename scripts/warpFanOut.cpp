@@ -0,0 +1,145 @@
+//File: warpFanOut.cpp
+//Brief: Writes one small file per systematic universe of a warped MC file for TransWarpExtraction to use as fake data.
+//       Each file only has the histograms that TransWarpExtraction reads, with that universe swapped in as the CV,
+//       and POTUsed.  SwapSysUnivWithCV writes a whole copy of the warped file for every universe instead, which
+//       adds up to tens of GB for studies with many universes.  Files are named like SwapSysUnivWithCV's:
+//       <warped file>_<band name>_<universe>.root
+//       Give it a list of error bands to only write their universes.  runWarping.make writes one band at a time
+//       so that unfolding the first bands starts while the others are still being written.
+//Usage: root -l -b -q warpFanOut.cpp+("merged/study_warpedMC.root", "warps", "Tracker_Neutron_Multiplicity_SelectedMCEvents,Tracker_Neutron_Multiplicity_EfficiencyNumerator", "Flux,GENIE_MaCCQE")
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+
+//ROOT includes
+#include "TFile.h"
+
+//c++ includes
+#include <iostream>
+#include <sstream>
+#include <memory>
+#include <map>
+#include <set>
+
+namespace
+{
+  std::vector<std::string> split(const std::string& list, const char delim)
+  {
+    std::vector<std::string> words;
+    std::stringstream stream(list);
+    std::string word;
+    while(std::getline(stream, word, delim)) words.push_back(word);
+    return words;
+  }
+
+  //Every universe of every vertical and lateral error band in hist by band name
+  std::map<std::string, std::vector<const TH1D*>> universes(const PlotUtils::MnvH1D& hist)
+  {
+    std::map<std::string, std::vector<const TH1D*>> found;
+
+    for(const auto& name: hist.GetVertErrorBandNames())
+    {
+      const auto band = hist.GetVertErrorBand(name);
+      for(unsigned int whichUniv = 0; whichUniv < band->GetNHists(); ++whichUniv) found[name].push_back(band->GetHist(whichUniv));
+    }
+
+    for(const auto& name: hist.GetLatErrorBandNames())
+    {
+      const auto band = hist.GetLatErrorBand(name);
+      for(unsigned int whichUniv = 0; whichUniv < band->GetNHists(); ++whichUniv) found[name].push_back(band->GetHist(whichUniv));
+    }
+
+    return found;
+  }
+}
+
+//bandNames is a comma-separated list of error bands to write.  Every band gets written when it's empty.
+int warpFanOut(const std::string& warpedFileName, const std::string& outDir, const std::string& histNames, const std::string& bandNames = "")
+{
+  TH1::AddDirectory(false); //I'll decide which file each histogram goes to
+
+  std::unique_ptr<TFile> warpedFile(TFile::Open(warpedFileName.c_str(), "READ"));
+  if(!warpedFile)
+  {
+    std::cerr << "Failed to open a file named " << warpedFileName << ".\n";
+    return 1;
+  }
+
+  //Look up every universe of every histogram once
+  std::vector<std::string> names = ::split(histNames, ',');
+  std::vector<std::map<std::string, std::vector<const TH1D*>>> histUniverses;
+  for(const auto& name: names)
+  {
+    auto hist = dynamic_cast<PlotUtils::MnvH1D*>(warpedFile->Get(name.c_str()));
+    if(!hist)
+    {
+      std::cerr << "Failed to find an MnvH1D named " << name << " in " << warpedFileName << ".\n";
+      return 2;
+    }
+    histUniverses.push_back(::universes(*hist));
+  }
+
+  if(histUniverses.empty())
+  {
+    std::cerr << "No histograms to write for warped universes.\n";
+    return 2;
+  }
+
+  auto pot = warpedFile->Get("POTUsed");
+  if(!pot) std::cerr << warpedFileName << " doesn't have POT information.  The warped universes won't either.\n";
+
+  const auto bandList = ::split(bandNames, ',');
+  const std::set<std::string> bandsToWrite(bandList.begin(), bandList.end());
+  for(const auto& band: bandsToWrite)
+  {
+    if(histUniverses.front().count(band) == 0)
+    {
+      std::cerr << "Failed to find an error band named " << band << " in " << names.front() << " from " << warpedFileName << ".\n";
+      return 5;
+    }
+  }
+
+  const size_t lastSlash = warpedFileName.rfind('/');
+  const std::string baseName = warpedFileName.substr(lastSlash + 1, warpedFileName.find(".root") - lastSlash - 1);
+
+  //All histograms come from the same ProcessAnaTuples job, so they have the same universes.
+  int nFiles = 0;
+  for(const auto& band: histUniverses.front())
+  {
+    if(!bandsToWrite.empty() && bandsToWrite.count(band.first) == 0) continue;
+
+    for(size_t whichUniv = 0; whichUniv < band.second.size(); ++whichUniv)
+    {
+      const std::string outName = outDir + "/" + baseName + "_" + band.first + "_" + std::to_string(whichUniv) + ".root";
+      std::unique_ptr<TFile> outFile(TFile::Open(outName.c_str(), "RECREATE"));
+      if(!outFile)
+      {
+        std::cerr << "Failed to create a file named " << outName << ".\n";
+        return 3;
+      }
+
+      for(size_t whichHist = 0; whichHist < names.size(); ++whichHist)
+      {
+        const auto& univs = histUniverses[whichHist][band.first];
+        if(univs.size() != band.second.size())
+        {
+          std::cerr << names[whichHist] << " has " << univs.size() << " universes for " << band.first << ", but "
+                    << names.front() << " has " << band.second.size() << ".  Can't make a consistent warp.\n";
+          return 4;
+        }
+
+        PlotUtils::MnvH1D swapped(*univs[whichUniv]);
+        swapped.SetName(names[whichHist].c_str());
+        outFile->WriteTObject(&swapped, names[whichHist].c_str());
+      }
+      if(pot) outFile->WriteTObject(pot, "POTUsed");
+
+      ++nFiles;
+    }
+  }
+
+  std::cout << "Wrote " << nFiles << " warped universes from " << warpedFileName << " to " << outDir << ".\n";
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+//File: warpedUniverses.cpp
+//Brief: Lists the error bands of a histogram in a warped MC file and how many universes each one has.
+//       runWarping.make uses the list to know every warped universe file that warpFanOut.cpp will write
+//       before it writes them.  That way, it can start unfolding each universe as soon as its file exists.
+//       Writes one line per band to outFileName: <band name> <number of universes>
+//Usage: root -l -b -q warpedUniverses.cpp+("merged/study_warpedMC.root", "Tracker_Neutron_Multiplicity_SelectedMCEvents", "warps/bands.txt")
+//Author: Andrew Olivier aolivier@ur.rochester.edu
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+
+//ROOT includes
+#include "TFile.h"
+
+//c++ includes
+#include <iostream>
+#include <fstream>
+#include <memory>
+
+int warpedUniverses(const std::string& warpedFileName, const std::string& histName, const std::string& outFileName)
+{
+  std::unique_ptr<TFile> warpedFile(TFile::Open(warpedFileName.c_str(), "READ"));
+  if(!warpedFile)
+  {
+    std::cerr << "Failed to open a file named " << warpedFileName << ".\n";
+    return 1;
+  }
+
+  auto hist = dynamic_cast<PlotUtils::MnvH1D*>(warpedFile->Get(histName.c_str()));
+  if(!hist)
+  {
+    std::cerr << "Failed to find an MnvH1D named " << histName << " in " << warpedFileName << ".\n";
+    return 2;
+  }
+
+  std::ofstream outFile(outFileName);
+  if(!outFile)
+  {
+    std::cerr << "Failed to create a file named " << outFileName << ".\n";
+    return 3;
+  }
+
+  //Same order that warpFanOut.cpp finds them in
+  for(const auto& name: hist->GetVertErrorBandNames()) outFile << name << " " << hist->GetVertErrorBand(name)->GetNHists() << "\n";
+  for(const auto& name: hist->GetLatErrorBandNames()) outFile << name << " " << hist->GetLatErrorBand(name)->GetNHists() << "\n";
+
+  return 0;
+}
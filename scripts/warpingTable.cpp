@@ -1,37 +1,92 @@
 //File: warpingTable.cpp
 //Brief: Prints warping study results for a table using a file produced by TransWarpExtractor.
+//       Compiled with -DBUILD_STANDALONE (scripts/CMakeLists.txt does this), it becomes a warpingTable
+//       program that summarizes a whole directory of TransWarpExtraction files on a pool of threads
+//       and writes one combined .csv without starting ROOT once per file.  The program also drives
+//       adaptiveTransWarp.sh's iteration scan: --next-iterations lists the iterations that would pin down
+//       where chi2 crosses NDOF and 5*NDOF and where it's smallest, and --combine adds up the chi2 profiles
+//       from each round of the scan.
+//Usage: root -l -b -q warpingTable.cpp("transWarp/Warping_someUniverse.root")
+//       warpingTable [-j nThreads] [-o combined.csv] directoryOrGlob...
+//       warpingTable --next-iterations scanSoFar.root
+//       warpingTable --combine output.root rounds.root...
 //Author: Andrew Olivier aolivier@ur.rochester.edu
 
 #include "TFile.h"
 #include "TProfile.h"
+#include "TCanvas.h"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <memory>
 
-int warpingTable(const std::string& fileName)
+namespace
 {
-  auto file = TFile::Open(fileName.c_str(), "READ");
+  constexpr auto chi2ProfileName = "Chi2_Iteration_Dists/m_avg_chi2_modelData_trueData_iter_chi2_truncated";
 
-  const size_t lastSlash = fileName.rfind('/');
-  const std::string outName = fileName.substr(lastSlash + 1, fileName.find(".root") - lastSlash - 1);
+  //auto migrationMatrix = TODO;
+  const int NDOF = 4; //migrationMatrix->GetXaxis()->GetNbins() - 2;
 
-  const std::string toSearchFor = "warpedMC";
-  const std::string univName = outName.substr(outName.find(toSearchFor) + toSearchFor.length(), std::string::npos);
+  //Strips the directory and .root from a TransWarpExtraction file name
+  std::string baseName(const std::string& fileName)
+  {
+    const size_t lastSlash = fileName.rfind('/');
+    return fileName.substr(lastSlash + 1, fileName.find(".root") - lastSlash - 1);
+  }
 
-  file->cd("Chi2_Iteration_Dists");
-  auto chi2VsIterations = static_cast<TProfile*>(gDirectory->Get("m_avg_chi2_modelData_trueData_iter_chi2_truncated"));
+  std::string universeName(const std::string& outName)
+  {
+    const std::string toSearchFor = "warpedMC";
+    return outName.substr(outName.find(toSearchFor) + toSearchFor.length(), std::string::npos);
+  }
 
-  //auto migrationMatrix = TODO;
-  const int NDOF = 4; //migrationMatrix->GetXaxis()->GetNbins() - 2;
+  //Bin with the smallest average chi2 among the iterations that were actually unfolded.
+  //An adaptive scan leaves empty bins between the iterations it evaluated, and their 0 isn't a real chi2.
+  int minimumFilledBin(const TProfile& chi2VsIterations)
+  {
+    int minBin = chi2VsIterations.GetMinimumBin();
+    for(int whichBin = 1; whichBin <= chi2VsIterations.GetNbinsX(); ++whichBin)
+    {
+      if(chi2VsIterations.GetBinEntries(whichBin) > 0 && (chi2VsIterations.GetBinEntries(minBin) <= 0 || chi2VsIterations.GetBinContent(whichBin) < chi2VsIterations.GetBinContent(minBin))) minBin = whichBin;
+    }
+    return minBin;
+  }
+
+  //Interesting convergence statistics as one line of a .csv file for a spreadsheet program to read later.
+  std::string summarize(const TProfile& chi2VsIterations, const std::string& univName)
+  {
+    const int minBin = minimumFilledBin(chi2VsIterations);
+    std::stringstream summary;
+    summary << univName << "," << chi2VsIterations.GetBinContent(minBin) << "," << chi2VsIterations.GetBinCenter(minBin) << "," << chi2VsIterations.GetBinCenter(chi2VsIterations.FindFirstBinAbove(NDOF)) << "," << chi2VsIterations.GetBinCenter(chi2VsIterations.FindFirstBinAbove(NDOF*5)) << "," << chi2VsIterations.GetBinCenter(chi2VsIterations.FindLastBinAbove(NDOF)) << "," << chi2VsIterations.GetBinCenter(chi2VsIterations.FindLastBinAbove(NDOF*5)) << std::endl;
+    return summary.str();
+  }
+}
+
+int warpingTable(const std::string& fileName)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+  if(!file)
+  {
+    std::cerr << "Failed to open a file named " << fileName << ".\n";
+    return 1;
+  }
+
+  const std::string outName = ::baseName(fileName);
+
+  auto chi2VsIterations = dynamic_cast<TProfile*>(file->Get(::chi2ProfileName));
+  if(!chi2VsIterations)
+  {
+    std::cerr << "Failed to find a TProfile named " << ::chi2ProfileName << " in " << fileName << ".\n";
+    return 2;
+  }
 
   //Write interesting convergence statistics to a .csv file for a spreadsheet program to read later.
-  std::stringstream summary;
-  summary << univName << "," << chi2VsIterations->GetMinimum() << "," << chi2VsIterations->GetBinCenter(chi2VsIterations->GetMinimumBin()) << "," << chi2VsIterations->GetBinCenter(chi2VsIterations->FindFirstBinAbove(NDOF)) << "," << chi2VsIterations->GetBinCenter(chi2VsIterations->FindFirstBinAbove(NDOF*5)) << "," << chi2VsIterations->GetBinCenter(chi2VsIterations->FindLastBinAbove(NDOF)) << "," << chi2VsIterations->GetBinCenter(chi2VsIterations->FindLastBinAbove(NDOF*5)) << std::endl;
+  const std::string summary = ::summarize(*chi2VsIterations, ::universeName(outName));
 
   std::ofstream outFile(outName + ".csv");
-  outFile << summary.str();
-  std::cout << summary.str();
+  outFile << summary;
+  std::cout << summary;
 
   TCanvas can(outName.c_str());
   can.cd();
@@ -40,3 +95,291 @@ int warpingTable(const std::string& fileName)
 
   return 0;
 }
+
+#ifdef BUILD_STANDALONE
+//ROOT includes
+#include "TROOT.h"
+
+//c++ includes
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <set>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+//POSIX includes
+#include <glob.h>
+#include <sys/stat.h>
+
+namespace
+{
+  //A directory means every .root file in it.  Anything else is a glob pattern that the shell didn't expand.
+  std::vector<std::string> expandInputs(const std::vector<std::string>& patterns)
+  {
+    std::vector<std::string> fileNames;
+    for(const auto& pattern: patterns)
+    {
+      struct stat info;
+      const std::string toGlob = (stat(pattern.c_str(), &info) == 0 && S_ISDIR(info.st_mode))?pattern + "/*.root":pattern;
+
+      glob_t found;
+      if(glob(toGlob.c_str(), 0, nullptr, &found) == 0)
+      {
+        fileNames.insert(fileNames.end(), found.gl_pathv, found.gl_pathv + found.gl_pathc);
+      }
+      else std::cerr << "Nothing matched " << toGlob << ".\n";
+      globfree(&found);
+    }
+
+    return fileNames;
+  }
+
+  //A positive number of threads, or 0 if value isn't one
+  int parseThreads(const std::string& value)
+  {
+    char* end = nullptr;
+    const long nThreads = std::strtol(value.c_str(), &end, 10);
+    if(value.empty() || *end != '\0' || nThreads < 1 || nThreads > std::numeric_limits<int>::max()) return 0;
+    return nThreads;
+  }
+}
+
+//Iterations to unfold next so that the iteration where chi2 first and last goes above each threshold and the
+//iteration where it's smallest are each next to an iteration on the other side.  Bisects every gap that
+//doesn't satisfy that yet.  Empty when the scan is done.
+std::set<int> nextIterations(const TProfile& chi2VsIterations)
+{
+  //Iterations that have been unfolded so far and their average chi2
+  std::vector<std::pair<int, double>> evaluated;
+  for(int whichBin = 1; whichBin <= chi2VsIterations.GetNbinsX(); ++whichBin)
+  {
+    if(chi2VsIterations.GetBinEntries(whichBin) > 0) evaluated.emplace_back(std::lround(chi2VsIterations.GetBinCenter(whichBin)), chi2VsIterations.GetBinContent(whichBin));
+  }
+
+  std::set<int> next;
+  if(evaluated.empty()) return next;
+
+  //Ask for the iteration halfway between evaluated[lower] and evaluated[upper] unless they're already neighbors
+  auto bisect = [&evaluated, &next](const size_t lower, const size_t upper)
+  {
+    if(lower < upper && upper < evaluated.size() && evaluated[upper].first - evaluated[lower].first > 1)
+    {
+      next.insert((evaluated[lower].first + evaluated[upper].first)/2);
+    }
+  };
+
+  auto isAbove = [](const double threshold) { return [threshold](const std::pair<int, double>& iter) { return iter.second > threshold; }; };
+  for(const double threshold: {1.*NDOF, 5.*NDOF})
+  {
+    const auto first = std::find_if(evaluated.begin(), evaluated.end(), isAbove(threshold));
+    if(first != evaluated.end())
+    {
+      const size_t firstIndex = std::distance(evaluated.begin(), first),
+                   lastIndex = evaluated.size() - 1 - std::distance(evaluated.rbegin(), std::find_if(evaluated.rbegin(), evaluated.rend(), isAbove(threshold)));
+      if(firstIndex > 0) bisect(firstIndex - 1, firstIndex);
+      bisect(lastIndex, lastIndex + 1);
+    }
+  }
+
+  const size_t minIndex = std::distance(evaluated.begin(), std::min_element(evaluated.begin(), evaluated.end(),
+                                                                            [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; }));
+  if(minIndex > 0) bisect(minIndex - 1, minIndex);
+  bisect(minIndex, minIndex + 1);
+
+  return next;
+}
+
+//Put the chi2 profiles from every round of an adaptive scan into one profile with a bin for each iteration up to
+//the largest one evaluated.  Replaces the profile in outName, which should be a copy of one of the rounds so that
+//it keeps everything else TransWarpExtraction wrote.
+int combineScans(const std::string& outName, const std::vector<std::string>& roundNames)
+{
+  std::vector<std::unique_ptr<TFile>> roundFiles;
+  std::vector<const TProfile*> rounds;
+  int maxIter = 1;
+  for(const auto& roundName: roundNames)
+  {
+    roundFiles.emplace_back(TFile::Open(roundName.c_str(), "READ"));
+    auto round = roundFiles.back()?dynamic_cast<TProfile*>(roundFiles.back()->Get(::chi2ProfileName)):nullptr;
+    if(!round)
+    {
+      std::cerr << "Failed to read a TProfile named " << ::chi2ProfileName << " from " << roundName << ".\n";
+      return 5;
+    }
+    rounds.push_back(round);
+
+    for(int whichBin = 1; whichBin <= round->GetNbinsX(); ++whichBin)
+    {
+      if(round->GetBinEntries(whichBin) > 0) maxIter = std::max<int>(maxIter, std::lround(round->GetBinCenter(whichBin)));
+    }
+  }
+
+  if(rounds.empty())
+  {
+    std::cerr << "No adaptive scan rounds to combine.\n";
+    return 5;
+  }
+
+  std::unique_ptr<TFile> outFile(TFile::Open(outName.c_str(), "UPDATE"));
+  if(!outFile)
+  {
+    std::cerr << "Failed to open " << outName << " to update it.\n";
+    return 6;
+  }
+
+  const std::string profileName = ::chi2ProfileName;
+  const std::string dirName = profileName.substr(0, profileName.find('/')), histName = profileName.substr(profileName.find('/') + 1);
+
+  TProfile combined(histName.c_str(), rounds.front()->GetTitle(), maxIter, 0.5, maxIter + 0.5, rounds.front()->GetErrorOption());
+  combined.SetDirectory(nullptr);
+  combined.GetXaxis()->SetTitle(rounds.front()->GetXaxis()->GetTitle());
+  combined.GetYaxis()->SetTitle(rounds.front()->GetYaxis()->GetTitle());
+  combined.Sumw2();
+
+  //A TProfile bin is a sum of weights, a sum of weight*chi2, a sum of weight*chi2^2, and a sum of weight^2.
+  //Adding those up bin by bin is the same as having filled every iteration in one job.
+  double nEntries = 0;
+  for(const auto round: rounds)
+  {
+    for(int whichBin = 1; whichBin <= round->GetNbinsX(); ++whichBin)
+    {
+      const double entries = round->GetBinEntries(whichBin);
+      if(entries <= 0) continue;
+
+      //TProfile::SetBinContent() sets the sum of weight*chi2, but GetBinContent() returns the average
+      const int outBin = combined.FindBin(round->GetBinCenter(whichBin));
+      const double sumSoFar = combined.GetBinContent(outBin)*combined.GetBinEntries(outBin);
+      combined.SetBinEntries(outBin, combined.GetBinEntries(outBin) + entries);
+      combined.SetBinContent(outBin, sumSoFar + round->GetBinContent(whichBin)*entries);
+      (*combined.GetSumw2())[outBin] += round->GetSumw2()->At(whichBin);
+      if(round->GetBinSumw2()->GetSize() > 0) (*combined.GetBinSumw2())[outBin] += round->GetBinSumw2()->At(whichBin);
+      else (*combined.GetBinSumw2())[outBin] += entries;
+    }
+    nEntries += round->GetEntries();
+  }
+  combined.SetEntries(nEntries);
+
+  auto dir = outFile->GetDirectory(dirName.c_str());
+  if(!dir) dir = outFile->mkdir(dirName.c_str());
+  dir->WriteTObject(&combined, histName.c_str(), "Overwrite");
+
+  return 0;
+}
+
+//Summarize every file in fileNames on nThreads threads.  Rows come out in the same order as fileNames
+//so that the combined .csv doesn't depend on which thread finished first.
+int warpingTableBatch(const std::vector<std::string>& fileNames, const std::string& combinedName, const int nThreads)
+{
+  ROOT::EnableThreadSafety();
+
+  std::vector<std::string> rows(fileNames.size());
+  std::atomic<size_t> nextFile(0);
+  std::atomic<int> nFailed(0);
+
+  auto worker = [&]()
+  {
+    for(size_t whichFile = nextFile++; whichFile < fileNames.size(); whichFile = nextFile++)
+    {
+      const auto& fileName = fileNames[whichFile];
+      std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+      auto chi2VsIterations = file?dynamic_cast<TProfile*>(file->Get(::chi2ProfileName)):nullptr;
+      if(!chi2VsIterations)
+      {
+        std::cerr << "Failed to read a TProfile named " << ::chi2ProfileName << " from " << fileName << ".  Skipping it.\n";
+        ++nFailed;
+        continue;
+      }
+
+      rows[whichFile] = ::summarize(*chi2VsIterations, ::universeName(::baseName(fileName)));
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for(int whichThread = 0; whichThread < nThreads; ++whichThread) pool.emplace_back(worker);
+  for(auto& thread: pool) thread.join();
+
+  std::ofstream combined(combinedName);
+  if(!combined)
+  {
+    std::cerr << "Failed to open " << combinedName << " for writing.\n";
+    return 2;
+  }
+  for(const auto& row: rows) combined << row;
+
+  std::cout << "Summarized " << fileNames.size() - nFailed << " of " << fileNames.size() << " warping studies into " << combinedName << ".\n";
+  return (nFailed > 0)?1:0;
+}
+
+int main(const int argc, const char** argv)
+{
+  const std::string usage = std::string("USAGE: ") + argv[0] + " [-j nThreads] [-o combined.csv] directoryOrGlob...\n"
+                          + "       " + argv[0] + " --next-iterations scanSoFar.root\n"
+                          + "       " + argv[0] + " --combine output.root rounds.root...\n";
+
+  //Adaptive iteration scan helpers for adaptiveTransWarp.sh
+  if(argc == 3 && std::string(argv[1]) == "--next-iterations")
+  {
+    std::unique_ptr<TFile> file(TFile::Open(argv[2], "READ"));
+    auto chi2VsIterations = file?dynamic_cast<TProfile*>(file->Get(::chi2ProfileName)):nullptr;
+    if(!chi2VsIterations)
+    {
+      std::cerr << "Failed to read a TProfile named " << ::chi2ProfileName << " from " << argv[2] << ".\n";
+      return 5;
+    }
+
+    std::string separator = "";
+    for(const int iter: nextIterations(*chi2VsIterations))
+    {
+      std::cout << separator << iter;
+      separator = ",";
+    }
+    std::cout << "\n";
+    return 0;
+  }
+
+  if(argc >= 4 && std::string(argv[1]) == "--combine") return combineScans(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+
+  int nThreads = std::max(1u, std::thread::hardware_concurrency());
+  std::string combinedName = "combined.csv";
+  std::vector<std::string> patterns;
+
+  for(int whichArg = 1; whichArg < argc; ++whichArg)
+  {
+    const std::string arg = argv[whichArg];
+    if((arg == "-j" || arg == "-o") && whichArg + 1 >= argc)
+    {
+      std::cerr << arg << " needs a value.\n" << usage;
+      return 3;
+    }
+
+    if(arg == "-j")
+    {
+      nThreads = ::parseThreads(argv[++whichArg]);
+      if(nThreads == 0)
+      {
+        std::cerr << "-j needs a positive number of threads, not " << argv[whichArg] << ".\n" << usage;
+        return 3;
+      }
+    }
+    else if(arg == "-o") combinedName = argv[++whichArg];
+    else if(arg == "-h" || arg == "--help")
+    {
+      std::cout << usage;
+      return 0;
+    }
+    else patterns.push_back(arg);
+  }
+
+  const auto fileNames = ::expandInputs(patterns);
+  if(fileNames.empty())
+  {
+    std::cerr << "No TransWarpExtraction files to summarize.\n" << usage;
+    return 4;
+  }
+
+  return warpingTableBatch(fileNames, combinedName, std::min<int>(nThreads, fileNames.size()));
+}
+#endif //BUILD_STANDALONE